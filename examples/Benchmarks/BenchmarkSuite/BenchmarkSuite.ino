@@ -0,0 +1,192 @@
+#include "TeensyTimerTool.h"
+
+using namespace TeensyTimerTool;
+
+// Benchmark suite, all values in cpu cycles measured with ARM_DWT_CYCCNT (T3.x / T4.x)
+//
+//   trigger:    cost of OneShotTimer::trigger() for each backend of the board
+//   latency:    cycles from the requested deadline (cycle counter before trigger() + delay) to the first statement
+//               of the callback. Includes the part of trigger() before the timer starts and the rounding of the
+//               delay to timer ticks, i.e. it can be slightly negative. TCK is polled by a tight tick() loop
+//   tickIdle:   TeensyTimerTool::tick() with param armed TCK timers, none of them due
+//   tickExpiry: TeensyTimerTool::tick() invoking one expired TCK timer
+//   yield:      yield() with param armed TCK timers, none of them due
+//
+// The callback mode, YIELD_TYPE and TCK_SCHEDULER are compile time settings. Run the suite once per setting
+// (userConfig.h) and concatenate the outputs. The number of armed timers is limited by NR_OF_TCK_TIMERS.
+//
+// Output (CSV): benchmark, callback mode, yield type, scheduler, timer, param, min, mean, max
+//
+// The suite also runs on the simulator (extras/simulator, cycles are lower bounds there). From the library folder:
+//   g++ -std=gnu++14 -O2 -DARDUINO_TEENSY40 -DTEENSYDUINO=153 -Iextras/simulator/include -Isrc
+//       -x c++ examples/Benchmarks/BenchmarkSuite/BenchmarkSuite.ino -x none extras/simulator/Sketch.cpp
+//       extras/simulator/src/*.cpp src/*.cpp src/ErrorHandling/*.cpp src/Teensy/TCK/*.cpp src/Teensy/PIT4/*.cpp -o benchmarks
+// To compare settings copy src/defaultConfig.h as userConfig.h into a folder, edit it and add -I<folder>.
+
+#if defined(ARDUINO_TEENSY40) || defined(ARDUINO_TEENSY41)
+TimerGenerator* const generators[] = {TMR1, TMR2_32, GPT1, GPT2, PIT, TCK};
+const char* const names[] = {"TMR1", "TMR2_32", "GPT1", "GPT2", "PIT", "TCK"};
+#elif defined(ARDUINO_TEENSY35) || defined(ARDUINO_TEENSY36)
+TimerGenerator* const generators[] = {FTM0, FTM1, FTM2, FTM3, TCK};
+const char* const names[] = {"FTM0", "FTM1", "FTM2", "FTM3", "TCK"};
+#elif defined(ARDUINO_TEENSY31) || defined(ARDUINO_TEENSY32)
+TimerGenerator* const generators[] = {FTM0, FTM1, FTM2, TCK};
+const char* const names[] = {"FTM0", "FTM1", "FTM2", "TCK"};
+#elif defined(ARDUINO_TEENSY30)
+TimerGenerator* const generators[] = {FTM0, FTM1, TCK};
+const char* const names[] = {"FTM0", "FTM1", "TCK"};
+#else
+    #error "The benchmarks need ARM_DWT_CYCCNT (T3.x / T4.x)"
+#endif
+
+#if defined(INPLACE_CALLBACKS)
+const char* const callbackMode = "inplace";
+#elif defined(PLAIN_VANILLA_CALLBACKS)
+const char* const callbackMode = "plain";
+#else
+const char* const callbackMode = "std::function";
+#endif
+
+#if YIELD_TYPE == YIELD_NONE
+const char* const yieldType = "none";
+#elif YIELD_TYPE == YIELD_STANDARD
+const char* const yieldType = "standard";
+#else
+const char* const yieldType = "optimized";
+#endif
+
+#if TCK_SCHEDULER == TCK_SCHEDULER_SCAN
+const char* const scheduler = "scan";
+#elif TCK_SCHEDULER == TCK_SCHEDULER_SORTED
+const char* const scheduler = "sorted";
+#elif TCK_SCHEDULER == TCK_SCHEDULER_WHEEL
+const char* const scheduler = "wheel";
+#else
+const char* const scheduler = "compact";
+#endif
+
+constexpr unsigned nrOfBackends = sizeof(generators) / sizeof(generators[0]);
+constexpr unsigned samples = 100;
+constexpr unsigned reps = 1000;
+constexpr uint32_t delayUs = 100;
+constexpr unsigned steps[] = {0, 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000};
+
+struct Stats
+{
+    int32_t min = INT32_MAX, max = INT32_MIN;
+    int64_t sum = 0;
+    unsigned n = 0;
+
+    void add(int32_t v)
+    {
+        if (v < min) min = v;
+        if (v > max) max = v;
+        sum += v;
+        n++;
+    }
+};
+
+void report(const char* benchmark, const char* timer, unsigned param, const Stats& s)
+{
+    if (s.n == 0) return;
+    Serial.printf("%s,%s,%s,%s,%s,%u,%d,%d,%d\n", benchmark, callbackMode, yieldType, scheduler, timer, param,
+                  (int)s.min, (int)(s.sum / (int64_t)s.n), (int)s.max);
+}
+
+volatile uint32_t firedCnt; // cycle counter at the start of the callback
+volatile bool fired;
+
+void onFire()
+{
+    firedCnt = ARM_DWT_CYCCNT;
+    fired = true;
+}
+
+uint32_t readOverhead; // cycles of two back to back cycle counter reads
+
+OneShotTimer* oneShots[nrOfBackends];
+OneShotTimer* tckProbe; // the TCK one shot timer, reused by the tick benchmark
+
+void benchmarkTrigger()
+{
+    for (unsigned b = 0; b < nrOfBackends; b++)
+    {
+        oneShots[b] = new OneShotTimer(generators[b]);
+        if (oneShots[b]->begin(onFire) != errorCode::OK) continue;
+        if (generators[b] == TCK) tckProbe = oneShots[b];
+
+        Stats cost, latency;
+        for (unsigned i = 0; i < samples; i++)
+        {
+            fired = false;
+            uint32_t t0 = ARM_DWT_CYCCNT;
+            oneShots[b]->trigger(delayUs);
+            uint32_t t1 = ARM_DWT_CYCCNT;
+
+            uint32_t timeout = micros();
+            while (!fired && micros() - timeout < 10 * delayUs) TeensyTimerTool::tick();
+            if (!fired) break;
+
+            cost.add(t1 - t0 - readOverhead);
+            latency.add((int32_t)(firedCnt - t0 - delayUs * (F_CPU / 1'000'000)));
+        }
+        report("trigger", names[b], delayUs, cost);
+        report("latency", names[b], delayUs, latency);
+    }
+}
+
+void benchmarkTick()
+{
+    unsigned armed = 0;
+
+    for (unsigned step : steps)
+    {
+        while (armed < step) // add timers far in the future, they never expire during the measurement
+        {
+            OneShotTimer* t = new OneShotTimer(TCK);
+            if (t->begin(onFire) != errorCode::OK) return; // NR_OF_TCK_TIMERS reached
+            t->trigger(5'000'000 + armed++);
+        }
+
+        Stats idle, expiry, yieldCost;
+        for (unsigned i = 0; i < reps; i++)
+        {
+            uint32_t t0 = ARM_DWT_CYCCNT;
+            TeensyTimerTool::tick();
+            idle.add(ARM_DWT_CYCCNT - t0 - readOverhead);
+
+            t0 = ARM_DWT_CYCCNT;
+            yield();
+            yieldCost.add(ARM_DWT_CYCCNT - t0 - readOverhead);
+        }
+        for (unsigned i = 0; tckProbe != nullptr && i < samples; i++)
+        {
+            tckProbe->trigger(2);
+            delayMicroseconds(5);
+            uint32_t t0 = ARM_DWT_CYCCNT;
+            TeensyTimerTool::tick();
+            expiry.add(ARM_DWT_CYCCNT - t0 - readOverhead);
+        }
+        report("tickIdle", "TCK", armed, idle);
+        report("tickExpiry", "TCK", armed, expiry);
+        report("yield", "TCK", armed, yieldCost);
+    }
+}
+
+void setup()
+{
+    while (!Serial) {}
+
+    ARM_DEMCR |= ARM_DEMCR_TRCENA;
+    ARM_DWT_CTRL |= ARM_DWT_CTRL_CYCCNTENA;
+    uint32_t t0 = ARM_DWT_CYCCNT;
+    readOverhead = ARM_DWT_CYCCNT - t0;
+
+    Serial.println("benchmark,callbacks,yield,scheduler,timer,param,min,mean,max");
+    benchmarkTrigger();
+    benchmarkTick();
+}
+
+void loop()
+{
+}
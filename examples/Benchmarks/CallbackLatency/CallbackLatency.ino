@@ -0,0 +1,91 @@
+#include "TeensyTimerTool.h"
+
+using namespace TeensyTimerTool;
+
+// Measures the latency from the timer event to the start of the callback for GPT, TMR and PIT (T4.x only).
+// The timers run in periodic mode and restart counting at the compare event. The counter value read
+// in the callback is the latency in timer ticks.
+//
+// Compile with the three callback modes (std::function (default), PLAIN_VANILLA_CALLBACKS and
+// INPLACE_CALLBACKS) in your userConfig.h and compare the output. For a good resolution use
+//   TMR_DEFAULT_PSC = PSC_1 (or PSC_AUTO) and USE_GPT_PIT_150MHz = true
+//
+// Output (CSV): callback mode, timer, min / mean / max latency in ns
+
+#if defined(ARDUINO_TEENSY40) || defined(ARDUINO_TEENSY41)
+
+constexpr unsigned nrOfSamples = 1000;
+
+PeriodicTimer gpt(GPT1), tmr(TMR1), pit(PIT);
+
+volatile uint32_t ticks[nrOfSamples];
+volatile unsigned sampleCnt;
+volatile PeriodicTimer* current; // only the timer under test stores samples
+
+// the counters restart at the compare event, the counter value is the latency in timer ticks
+void onGPT()
+{
+    uint32_t cnt = GPT1_CNT;
+    if (current == &gpt && sampleCnt < nrOfSamples) ticks[sampleCnt++] = cnt;
+}
+
+void onTMR()
+{
+    uint32_t cnt = IMXRT_TMR1.CH[0].CNTR; // first allocated channel
+    if (current == &tmr && sampleCnt < nrOfSamples) ticks[sampleCnt++] = cnt;
+}
+
+void onPIT()
+{
+    uint32_t cnt = IMXRT_PIT_CHANNELS[0].LDVAL - IMXRT_PIT_CHANNELS[0].CVAL; // first allocated channel, counts down
+    if (current == &pit && sampleCnt < nrOfSamples) ticks[sampleCnt++] = cnt;
+}
+
+void measure(const char* name, PeriodicTimer& timer, void (*callback)(), float tickFrequencyMHz)
+{
+    sampleCnt = 0;
+    current = &timer;
+    timer.begin(callback, 100); // 100µs
+    while (sampleCnt < nrOfSamples) {}
+    current = nullptr;
+
+    uint32_t min = 0xFFFF'FFFF, max = 0;
+    float sum = 0;
+    for (unsigned i = 0; i < nrOfSamples; i++)
+    {
+        if (ticks[i] < min) min = ticks[i];
+        if (ticks[i] > max) max = ticks[i];
+        sum += ticks[i];
+    }
+
+    float nsPerTick = 1000.0f / tickFrequencyMHz;
+#if defined(INPLACE_CALLBACKS)
+    const char* mode = "inplace";
+#elif defined(PLAIN_VANILLA_CALLBACKS)
+    const char* mode = "plain";
+#else
+    const char* mode = "std::function";
+#endif
+    Serial.printf("%s,%s,%.1f,%.1f,%.1f\n", mode, name, min * nsPerTick, sum / nrOfSamples * nsPerTick, max * nsPerTick);
+}
+
+void setup()
+{
+    while (!Serial) {}
+
+    float perclkMHz = USE_GPT_PIT_150MHz ? F_BUS_ACTUAL / 1E6f : 24.0f;
+    float tmrMHz = TMR_DEFAULT_PSC == PSC_AUTO ? 150.0f : 150.0f / (1 << (TMR_DEFAULT_PSC & 7)); // PSC_AUTO uses PSC_1 for 100µs
+
+    Serial.println("mode,timer,minNs,meanNs,maxNs");
+    measure("GPT1", gpt, onGPT, perclkMHz);
+    measure("TMR1", tmr, onTMR, tmrMHz);
+    measure("PIT", pit, onPIT, perclkMHz);
+}
+
+void loop()
+{
+}
+
+#else
+    #error "CallbackLatency needs a Teensy 4.x"
+#endif
@@ -0,0 +1,43 @@
+#include "TeensyTimerTool.h"
+
+using namespace TeensyTimerTool;
+
+// Function pointer callbacks with a context pointer. They are called directly without the
+// std::function overhead and work with PLAIN_VANILLA_CALLBACKS as well
+
+struct Blinker
+{
+    unsigned pin;
+    unsigned cnt = 0;
+};
+
+void blink(void* context) // context points to the Blinker passed to begin()
+{
+    Blinker* b = (Blinker*)context;
+    digitalToggleFast(b->pin);
+    b->cnt++;
+}
+
+void stopAfterTen(void* context) // without explicit context the timer itself is passed
+{
+    static unsigned cnt = 0;
+    if (++cnt == 10) ((BaseTimer*)context)->stop();
+}
+
+//==============================================================
+
+PeriodicTimer t1, t2;
+Blinker led{LED_BUILTIN};
+
+void setup()
+{
+    pinMode(LED_BUILTIN, OUTPUT);
+    t1.begin(blink, &led, 100'000);
+    t2.begin(stopAfterTen, 50'000);
+}
+
+void loop()
+{
+    Serial.println(led.cnt);
+    delay(500);
+}
@@ -0,0 +1,33 @@
+#include "TeensyTimerTool.h"
+
+using namespace TeensyTimerTool;
+
+// Static timers are bound to a channel and a handler at compile time. The module gets a
+// dedicated isr calling the handler directly which minimizes the interrupt overhead for
+// high rate timers. (Teensy 4.x: TMR, GPT, PIT, Teensy 3.x: FTM)
+
+void onTick()
+{
+    digitalToggleFast(LED_BUILTIN); // 50kHz square wave
+}
+
+#if defined(ARDUINO_TEENSY40) || defined(ARDUINO_TEENSY41)
+StaticPeriodicTimer<TMR_t<0>, 0, onTick> t1; // TMR1, channel 0
+PeriodicTimer t2(TMR1);                      // other channels of TMR1 can still be used normally
+#elif defined(ARDUINO_TEENSY30) || defined(ARDUINO_TEENSY31) || defined(ARDUINO_TEENSY32) || defined(ARDUINO_TEENSY35) || defined(ARDUINO_TEENSY36)
+StaticPeriodicTimer<FTM_t<0>, 0, onTick> t1; // FTM0, channel 0
+PeriodicTimer t2(FTM0);                      // other channels of FTM0 can still be used normally
+#else
+    #error "Static timers need a Teensy 3.x or 4.x"
+#endif
+
+void setup()
+{
+    pinMode(LED_BUILTIN, OUTPUT);
+    t1.begin(10_us); // 100kHz, converted and range checked at compile time
+    t2.begin([] { Serial.println("still alive"); }, 50'000);
+}
+
+void loop()
+{
+}
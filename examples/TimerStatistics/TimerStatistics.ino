@@ -0,0 +1,45 @@
+#include "TeensyTimerTool.h"
+
+using namespace TeensyTimerTool;
+
+// Prints the lateness statistics (timer event to callback, cpu cycles) of a hardware and a TCK timer
+// once per second. Requires #define ENABLE_TIMER_STATS in userConfig.h, see defaultConfig.h
+
+#if !defined(ENABLE_TIMER_STATS)
+    #error "Please define ENABLE_TIMER_STATS in userConfig.h"
+#endif
+
+#if defined(ARDUINO_TEENSY40) || defined(ARDUINO_TEENSY41)
+PeriodicTimer t1(GPT1), t2(TCK);
+const char* const hwName = "GPT1";
+#elif defined(ARDUINO_TEENSY30) || defined(ARDUINO_TEENSY31) || defined(ARDUINO_TEENSY32) || defined(ARDUINO_TEENSY35) || defined(ARDUINO_TEENSY36)
+PeriodicTimer t1(FTM0), t2(TCK);
+const char* const hwName = "FTM0";
+#else
+    #error "This example needs a Teensy 3.x or 4.x"
+#endif
+
+void print(const char* name, const TimerStats& s)
+{
+    Serial.printf("%-5s calls: %6lu  overruns: %4lu  min: %6lu  mean: %8.1f  max: %6lu\n", name, s.count, s.overruns, s.min, s.mean(), s.max);
+    Serial.print("      histogram (log2):");
+    for (unsigned bin = 0; bin < TimerStats::nrOfBins; bin++)
+    {
+        if (s.histogram[bin] != 0) Serial.printf(" <%lu: %lu", bin == 0 ? 1ul : 1ul << bin, s.histogram[bin]);
+    }
+    Serial.println();
+}
+
+void setup()
+{
+    t1.begin([] { digitalToggleFast(LED_BUILTIN); }, 100);
+    t2.begin([] {}, 1'000);
+    pinMode(LED_BUILTIN, OUTPUT);
+}
+
+void loop()
+{
+    delay(1000);
+    print(hwName, t1.getStats(true)); // snapshot and reset, i.e. statistics of the last second
+    print("TCK", t2.getStats(true));
+}
@@ -0,0 +1,30 @@
+// Timer driven code on a Linux host
+//
+// The same PeriodicTimer / OneShotTimer code runs on Linux, the timers are
+// served by the host backend (src/Linux) instead of the Teensy hardware.
+//
+// Build from the library folder:
+//   g++ -std=gnu++14 -O2 -pthread -Isrc extras/host/HelloHost.cpp
+//       src/*.cpp src/ErrorHandling/*.cpp src/Linux/*.cpp -o helloHost
+
+#include "TeensyTimerTool.h"
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+using namespace TeensyTimerTool;
+
+PeriodicTimer t1;   // from the timer pool
+OneShotTimer t2(TCK);
+
+int main()
+{
+    t1.begin([] { puts("periodic"); }, 250'000); // 250ms
+    t2.begin([] { puts("one shot"); });
+
+    for (int i = 0; i < 5; i++)
+    {
+        t2.trigger(100_ms);
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+}
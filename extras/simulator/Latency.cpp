@@ -0,0 +1,74 @@
+// Interrupt latency of the timer backends
+//
+// Runs periodic timers on every backend of the board on the register level
+// simulator and prints the latency from the interrupt request to the callback
+// and the min / max period, all in cpu cycles. The results are deterministic.
+//
+// Build from the library folder for the T4.0 (QUAD, GPT, PIT, TCK):
+//   g++ -std=gnu++14 -O2 -DARDUINO_TEENSY40 -DTEENSYDUINO=153 -Iextras/simulator/include -Isrc
+//       extras/simulator/Latency.cpp extras/simulator/src/*.cpp src/*.cpp src/ErrorHandling/*.cpp
+//       src/Teensy/TCK/*.cpp src/Teensy/PIT4/*.cpp -o latency
+//
+// or with -DARDUINO_TEENSY36 for the T3.6 (FTM, TCK).
+
+#include "TeensyTimerTool.h"
+#include <algorithm>
+
+using namespace TeensyTimerTool;
+
+struct Probe
+{
+    const char* name;
+    uint32_t calls = 0;
+    uint64_t last = 0;
+    uint64_t latMin = ~0ull, latMax = 0, latSum = 0;
+    uint64_t perMin = ~0ull, perMax = 0;
+
+    void operator()()
+    {
+        uint64_t now = sim::now();
+        uint64_t latency = sim::irqLatency(); // 0 for TCK, its callbacks are invoked from yield()
+
+        latMin = std::min(latMin, latency);
+        latMax = std::max(latMax, latency);
+        latSum += latency;
+        if (calls++ > 0)
+        {
+            perMin = std::min(perMin, now - last);
+            perMax = std::max(perMax, now - last);
+        }
+        last = now;
+    }
+};
+
+#if defined(ARDUINO_TEENSY40) || defined(ARDUINO_TEENSY41)
+TimerGenerator* const generators[] = {TMR1, TMR2_32, GPT1, GPT2, PIT, PIT, TCK};
+Probe probes[] = {{"TMR1"}, {"TMR2_32"}, {"GPT1"}, {"GPT2"}, {"PIT"}, {"PIT"}, {"TCK"}};
+#else
+TimerGenerator* const generators[] = {FTM0, FTM1, FTM2, FTM3, TCK};
+Probe probes[] = {{"FTM0"}, {"FTM1"}, {"FTM2"}, {"FTM3"}, {"TCK"}};
+#endif
+
+constexpr unsigned nrOfTimers = sizeof(generators) / sizeof(generators[0]);
+PeriodicTimer* timers[nrOfTimers];
+
+int main()
+{
+    for (unsigned i = 0; i < nrOfTimers; i++)
+    {
+        Probe* probe = &probes[i];
+        timers[i] = new PeriodicTimer(generators[i]);
+        timers[i]->begin([probe] { (*probe)(); }, 100); // 10kHz
+    }
+
+    delay(100);
+
+    Serial.printf("F_CPU = %u Hz, period = %u cycles\n", F_CPU, F_CPU / 10'000);
+    Serial.printf("%-8s %6s %8s %8s %8s %8s %8s\n", "timer", "calls", "lat_min", "lat_avg", "lat_max", "per_min", "per_max");
+    for (Probe& p : probes)
+    {
+        Serial.printf("%-8s %6u %8llu %8llu %8llu %8llu %8llu\n", p.name, p.calls, (unsigned long long)p.latMin,
+                      (unsigned long long)(p.calls ? p.latSum / p.calls : 0), (unsigned long long)p.latMax,
+                      (unsigned long long)p.perMin, (unsigned long long)p.perMax);
+    }
+}
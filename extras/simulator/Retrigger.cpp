@@ -0,0 +1,93 @@
+// Retriggering TCK timers from their callbacks
+//
+// self:  a one shot timer does some work in its callback and then retriggers itself
+// other: the callback of one timer triggers a second timer, allocated after the first one
+// idle:  a timer is triggered after the TCK timers were idle for more than 2^31 cycles
+//
+// All need to fire after the requested delay, measured from the trigger() call. Prints the deviation
+// from this deadline in cpu cycles and returns 1 if a timer fired early or much too late.
+// Run it for each TCK_SCHEDULER (copy src/defaultConfig.h as userConfig.h into a folder and add -I<folder>).
+//
+// Build from the library folder:
+//   g++ -std=gnu++14 -O2 -DARDUINO_TEENSY40 -DTEENSYDUINO=153 -Iextras/simulator/include -Isrc
+//       extras/simulator/Retrigger.cpp extras/simulator/src/*.cpp src/*.cpp src/ErrorHandling/*.cpp
+//       src/Teensy/TCK/*.cpp src/Teensy/PIT4/*.cpp -o retrigger
+
+#include "TeensyTimerTool.h"
+#include <algorithm>
+
+using namespace TeensyTimerTool;
+
+constexpr uint32_t delayUs = 1000;
+constexpr uint64_t delayCycles = delayUs * (F_CPU / 1'000'000);
+constexpr int64_t tolerance = 5 * (F_CPU / 1'000'000); // wheel slots, yield loop and trigger correction
+constexpr unsigned rounds = 10;
+constexpr uint32_t idleGaps[] = {0x9000'0000, 0xC000'0000, 0xFFF0'0000}; // > 2^31 but < 2^32 cycles, TckClock needs a read per 2^32
+
+struct Result
+{
+    const char* name;
+    unsigned expected;
+    unsigned calls = 0;
+    int64_t errMin = INT64_MAX, errMax = INT64_MIN;
+
+    void add(uint64_t deadline)
+    {
+        int64_t err = (int64_t)(sim::now() - deadline);
+        errMin = std::min(errMin, err);
+        errMax = std::max(errMax, err);
+        calls++;
+    }
+
+    bool report() const
+    {
+        bool ok = calls == expected && errMin >= -tolerance && errMax <= tolerance;
+        Serial.printf("%-6s %6u %10lld %10lld  %s\n", name, calls, (long long)errMin, (long long)errMax, ok ? "ok" : "FAILED");
+        return ok;
+    }
+};
+
+OneShotTimer a(TCK), b(TCK);
+uint64_t deadlineA, deadlineB;
+Result self{"self", rounds}, other{"other", rounds}, idle{"idle", sizeof(idleGaps) / sizeof(idleGaps[0])};
+
+void retrigger(OneShotTimer& t, uint64_t& deadline)
+{
+    deadline = sim::now() + delayCycles;
+    t.trigger(delayUs);
+}
+
+int main()
+{
+    a.begin([] {
+        self.add(deadlineA);
+        sim::spend(2000); // some work before retriggering
+        if (self.calls < rounds) retrigger(a, deadlineA);
+    });
+    retrigger(a, deadlineA);
+    delay(rounds * delayUs / 1000 + 5);
+
+    a.begin([] {
+        if (other.calls < rounds) retrigger(b, deadlineB);
+    });
+    b.begin([] {
+        other.add(deadlineB);
+        retrigger(a, deadlineA);
+    });
+    retrigger(a, deadlineA);
+    delay(2 * rounds * delayUs / 1000 + 5);
+
+    a.begin([] { idle.add(deadlineA); });
+    for (uint32_t gap : idleGaps)
+    {
+        sim::spend(gap); // no yield, i.e. TCK doesn't see the counter for this time
+        retrigger(a, deadlineA);
+        delay(delayUs / 1000 + 5);
+    }
+
+    Serial.printf("%-6s %6s %10s %10s\n", "case", "calls", "err_min", "err_max");
+    bool ok = self.report();
+    ok = other.report() && ok;
+    ok = idle.report() && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,26 @@
+// Runs an Arduino sketch on the simulator
+//
+// Calls setup() and then loop() and yield() alternately, as the Teensy core does, for the simulated
+// milliseconds given on the command line (default 0, i.e. setup() only). Compile the sketch as C++
+// together with this file, e.g. from the library folder:
+//   g++ -std=gnu++14 -O2 -DARDUINO_TEENSY40 -DTEENSYDUINO=153 -Iextras/simulator/include -Isrc
+//       -x c++ path/to/sketch.ino -x none extras/simulator/Sketch.cpp extras/simulator/src/*.cpp src/*.cpp
+//       src/ErrorHandling/*.cpp src/Teensy/TCK/*.cpp src/Teensy/PIT4/*.cpp -o sketch
+
+#include "Arduino.h"
+#include "sim.h"
+#include <cstdlib>
+
+void setup();
+void loop();
+
+int main(int argc, char* argv[])
+{
+    uint64_t ms = argc > 1 ? strtoull(argv[1], nullptr, 10) : 0;
+
+    setup();
+    sim::run(ms * (F_CPU / 1'000), [] {
+        loop();
+        yield();
+    });
+}
@@ -0,0 +1,129 @@
+// Soak test in virtual time
+//
+// Runs a 1kHz periodic TCK timer and 20 chains of one shot timers taken from the timer pool (hardware
+// timers first, then TCK) for a simulated week. Each one shot callback re-triggers its timer with a
+// pseudo random delay of 1..50ms. The simulator jumps from one deadline to the next (sim::wakeup), still a
+// simulated day takes about 2 minutes of cpu time (measured on a desktop x86), a week about a quarter of an hour.
+// Use the days argument for quick runs. Since the simulation is deterministic the printed checksum over all
+// callback times is the same on every run, compare it after changing the library.
+//
+// Build from the library folder, see Latency.cpp for the T3.6 variant:
+//   g++ -std=gnu++14 -O2 -DARDUINO_TEENSY40 -DTEENSYDUINO=153 -Iextras/simulator/include -Isrc
+//       extras/simulator/Soak.cpp extras/simulator/src/*.cpp src/*.cpp src/ErrorHandling/*.cpp
+//       src/Teensy/TCK/*.cpp src/Teensy/PIT4/*.cpp -o soak
+//
+// Usage: soak [days], default 7
+
+#include "TeensyTimerTool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+
+using namespace TeensyTimerTool;
+
+constexpr uint64_t cyclesPerUs = F_CPU / 1'000'000;
+constexpr uint64_t cyclesPerDay = 86'400ull * F_CPU;
+constexpr unsigned nrOfChains = 20;
+
+uint64_t checksum = 0xcbf29ce484222325; // FNV-1a over (source, cycle) of all callbacks
+
+void record(unsigned source, uint64_t cycle)
+{
+    for (uint64_t v : {(uint64_t)source, cycle})
+        for (int i = 0; i < 8; i++, v >>= 8) checksum = (checksum ^ (v & 0xFF)) * 0x100000001b3;
+}
+
+// 1kHz heartbeat, phase is the deviation from the ideal time n * 1ms
+struct Heartbeat
+{
+    PeriodicTimer timer{TCK};
+    uint64_t start = 0, calls = 0;
+    int64_t phaseMin = 0, phaseMax = 0;
+
+    void begin()
+    {
+        start = sim::now();
+        timer.begin([this] { tick(); }, 1000);
+    }
+
+    void tick()
+    {
+        uint64_t now = sim::now();
+        int64_t phase = (int64_t)(now - start) - (int64_t)(++calls * 1000 * cyclesPerUs);
+        phaseMin = std::min(phaseMin, phase);
+        phaseMax = std::max(phaseMax, phase);
+        record(nrOfChains, now);
+    }
+} heartbeat;
+
+// one shot timer re-triggering itself. The error is measured from the exact deadline (trigger call + delay) to the
+// callback, it includes the rounding of the delay to timer ticks, i.e. callbacks can be slightly early.
+struct Chain
+{
+    OneShotTimer timer;
+    unsigned nr;
+    uint32_t seed;
+    uint64_t deadline = 0, calls = 0;
+    int64_t errMin = INT64_MAX, errMax = INT64_MIN, errSum = 0;
+
+    void begin(unsigned i)
+    {
+        nr = i;
+        seed = 0x9E3779B9 * (i + 1);
+        timer.begin([this] { fire(); });
+        next();
+    }
+
+    void next()
+    {
+        seed = seed * 1664525 + 1013904223; // deterministic LCG
+        uint32_t us = 1'000 + (seed >> 8) % 49'000;
+        deadline = sim::now() + us * cyclesPerUs;
+        timer.trigger(us);
+    }
+
+    void fire()
+    {
+        uint64_t now = sim::now();
+        int64_t err = (int64_t)(now - deadline);
+        calls++;
+        errMin = std::min(errMin, err);
+        errMax = std::max(errMax, err);
+        errSum += err;
+        record(nr, now);
+        next();
+    }
+} chains[nrOfChains];
+
+int main(int argc, char* argv[])
+{
+    unsigned days = argc > 1 ? atoi(argv[1]) : 7;
+    auto wallStart = std::chrono::steady_clock::now();
+    auto wall = [&] { return std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count(); };
+
+    sim::wakeup = tckTicksUntilDue; // virtual time, TCK ticks are cpu cycles on the T3.x/T4.x
+    heartbeat.begin();
+    for (unsigned i = 0; i < nrOfChains; i++) chains[i].begin(i);
+
+    Serial.printf("F_CPU = %u Hz, simulating %u day(s)\n", F_CPU, days);
+    Serial.printf("%4s %12s %12s %10s %10s %10s\n", "day", "heartbeats", "one shots", "phase_min", "phase_max", "wall [s]");
+    for (unsigned day = 1; day <= days; day++)
+    {
+        sim::run(cyclesPerDay, yield);
+
+        uint64_t shots = 0;
+        for (Chain& c : chains) shots += c.calls;
+        Serial.printf("%4u %12llu %12llu %10lld %10lld %10.1f\n", day, (unsigned long long)heartbeat.calls, (unsigned long long)shots,
+                      (long long)heartbeat.phaseMin, (long long)heartbeat.phaseMax, wall());
+    }
+
+    Serial.printf("\n%5s %12s %10s %8s %8s %8s\n", "chain", "max_per [ms]", "calls", "err_min", "err_avg", "err_max"); // max period tells the backend
+    for (Chain& c : chains)
+    {
+        Serial.printf("%5u %12.1f %10llu %8lld %8lld %8lld\n", c.nr, c.timer.getMaxPeriod() / 1000, (unsigned long long)c.calls, (long long)c.errMin,
+                      (long long)(c.calls ? c.errSum / (int64_t)c.calls : 0), (long long)c.errMax);
+    }
+    Serial.printf("\nheartbeats: expected %llu, got %llu\n", (unsigned long long)days * 86'400'000, (unsigned long long)heartbeat.calls);
+    Serial.printf("checksum %016llx\n", (unsigned long long)checksum);
+}
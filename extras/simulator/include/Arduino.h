@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Stream.h"
+#include "core_pins.h"
+
+void serialEvent();
+
+#if defined(KINETISK) || defined(KINETISL)
+extern Stream Serial1, Serial2, Serial3;
+void serialEvent1();
+void serialEvent2();
+void serialEvent3();
+#else
+class HardwareSerial
+{
+ public:
+    static bool serial_event_handlers_active;
+    static void processSerialEvents() {}
+};
+#endif
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "Arduino.h"
+
+class EventResponder
+{
+ public:
+    static void runFromYield() {}
+};
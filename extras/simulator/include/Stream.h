@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdarg>
+#include <cstdio>
+
+// Stream printing to stdout
+class Stream
+{
+ public:
+    int printf(const char* format, ...);
+    size_t print(const char* s) { return fputs(s, stdout) < 0 ? 0 : 1; }
+    size_t println(const char* s = "") { return std::printf("%s\n", s); }
+    size_t print(int v) { return std::printf("%d", v); }
+    size_t println(int v) { return std::printf("%d\n", v); }
+    size_t print(unsigned v) { return std::printf("%u", v); }
+    size_t println(unsigned v) { return std::printf("%u\n", v); }
+    size_t print(double v) { return std::printf("%.2f", v); }
+    size_t println(double v) { return std::printf("%.2f\n", v); }
+    int available() { return 0; }
+    void begin(unsigned long) {}
+    explicit operator bool() const { return true; }
+};
+
+extern Stream Serial;
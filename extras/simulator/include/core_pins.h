@@ -0,0 +1,45 @@
+#pragma once
+
+#include "sim.h"
+#include <cstddef>
+#include <cstdint>
+
+#if defined(ARDUINO_TEENSY40) || defined(ARDUINO_TEENSY41)
+    #include "imxrt.h"
+#else
+    #include "kinetis.h"
+#endif
+
+#define FASTRUN
+#define LED_BUILTIN 13
+#define INPUT 0
+#define OUTPUT 1
+#define HIGH 1
+#define LOW 0
+
+// cortex debug registers, the cycle counter runs on the virtual clock
+extern volatile uint32_t ARM_DEMCR, ARM_DWT_CTRL;
+#define ARM_DWT_CYCCNT (sim::cycleCounter())
+#define ARM_DEMCR_TRCENA (1 << 24)
+#define ARM_DWT_CTRL_CYCCNTENA (1 << 0)
+
+void attachInterruptVector(IRQ_NUMBER_t irq, void (*function)(void));
+void nvicEnable(IRQ_NUMBER_t irq, bool enable);
+#define NVIC_ENABLE_IRQ(n) nvicEnable((IRQ_NUMBER_t)(n), true)
+#define NVIC_DISABLE_IRQ(n) nvicEnable((IRQ_NUMBER_t)(n), false)
+
+#define __disable_irq() sim::disableIrq()
+#define __enable_irq() sim::enableIrq()
+static inline void noInterrupts() { sim::disableIrq(); }
+static inline void interrupts() { sim::enableIrq(); }
+
+uint32_t micros();
+uint32_t millis();
+void delay(uint32_t ms); // runs yield() until the time is over, as on the Teensy
+void delayMicroseconds(uint32_t us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWriteFast(uint8_t pin, uint8_t val);
+uint8_t digitalReadFast(uint8_t pin);
+void digitalToggleFast(uint8_t pin);
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "sim.h"
+#include <cstdint>
+
+// Simulated IMXRT1062 timer peripherals (QuadTimer, PIT, GPT) and the clock control registers used by the library
+
+#ifndef F_CPU
+    #define F_CPU 600000000
+#endif
+#define F_CPU_ACTUAL F_CPU
+#define F_BUS_ACTUAL 150000000
+
+enum IRQ_NUMBER_t
+{
+    IRQ_GPT1 = 100,
+    IRQ_GPT2 = 101,
+    IRQ_PIT = 122,
+    IRQ_QTIMER1 = 133,
+    IRQ_QTIMER2 = 134,
+    IRQ_QTIMER3 = 135,
+    IRQ_QTIMER4 = 136,
+};
+
+// QuadTimer ------------------------------------------------------------------------
+
+typedef struct
+{
+    sim::Register<uint16_t> COMP1, COMP2, CAPT, LOAD, HOLD, CNTR, CTRL, SCTRL, CMPLD1, CMPLD2, CSCTRL, FILT, DMA, unused1[2], ENBL;
+} IMXRT_TMR_CH_t;
+
+typedef struct
+{
+    IMXRT_TMR_CH_t CH[4];
+} IMXRT_TMR_t;
+
+extern IMXRT_TMR_t IMXRT_TMR1, IMXRT_TMR2, IMXRT_TMR3, IMXRT_TMR4;
+
+#define TMR_CTRL_CM(n) ((uint16_t)(((n) & 0x07) << 13))
+#define TMR_CTRL_PCS(n) ((uint16_t)(((n) & 0x0F) << 9))
+#define TMR_CTRL_SCS(n) ((uint16_t)(((n) & 0x03) << 7))
+#define TMR_CTRL_ONCE ((uint16_t)(1 << 6))
+#define TMR_CTRL_LENGTH ((uint16_t)(1 << 5))
+#define TMR_CTRL_DIR ((uint16_t)(1 << 4))
+#define TMR_CTRL_COINIT ((uint16_t)(1 << 3))
+#define TMR_CTRL_OUTMODE(n) ((uint16_t)(((n) & 0x07) << 0))
+#define TMR_CSCTRL_TCF1 ((uint16_t)(1 << 4))
+#define TMR_CSCTRL_TCF2 ((uint16_t)(1 << 5))
+#define TMR_CSCTRL_TCF1EN ((uint16_t)(1 << 6))
+#define TMR_CSCTRL_TCF2EN ((uint16_t)(1 << 7))
+#define TMR_CSCTRL_CL1(n) ((uint16_t)(((n) & 0x03) << 0))
+#define TMR_CSCTRL_CL2(n) ((uint16_t)(((n) & 0x03) << 2))
+
+// PIT ------------------------------------------------------------------------------
+
+typedef struct
+{
+    sim::Register<uint32_t> LDVAL, CVAL, TCTRL, TFLG;
+} IMXRT_PIT_CHANNEL_t;
+
+extern IMXRT_PIT_CHANNEL_t IMXRT_PIT_CHANNELS[4];
+extern sim::Register<uint32_t> PIT_MCR;
+
+#define PIT_TCTRL_TEN ((uint32_t)(1 << 0))
+#define PIT_TCTRL_TIE ((uint32_t)(1 << 1))
+#define PIT_TCTRL_CHN ((uint32_t)(1 << 2))
+#define PIT_TFLG_TIF ((uint32_t)(1 << 0))
+
+// GPT (register layout: TeensyTimerTool::IMXRT_GPT_t) ------------------------------
+
+extern sim::Register<uint32_t> IMXRT_GPT1[10], IMXRT_GPT2[10];
+
+#define GPT_CR_EN ((uint32_t)(1 << 0))
+#define GPT_CR_ENMOD ((uint32_t)(1 << 1))
+#define GPT_CR_CLKSRC(n) ((uint32_t)(((n) & 0x07) << 6))
+#define GPT_CR_FRR ((uint32_t)(1 << 9))
+#define GPT_IR_OF1IE ((uint32_t)(1 << 0))
+#define GPT_SR_OF1 ((uint32_t)(1 << 0))
+
+// CCM ------------------------------------------------------------------------------
+
+extern sim::Register<uint32_t> CCM_CCGR0, CCM_CCGR1, CCM_CSCMR1;
+
+#define CCM_CCGR_ON 3
+#define CCM_CCGR0_GPT2_BUS(n) ((uint32_t)(((n) & 0x03) << 24))
+#define CCM_CCGR0_GPT2_SERIAL(n) ((uint32_t)(((n) & 0x03) << 26))
+#define CCM_CCGR1_PIT(n) ((uint32_t)(((n) & 0x03) << 12))
+#define CCM_CCGR1_GPT1_BUS(n) ((uint32_t)(((n) & 0x03) << 20))
+#define CCM_CCGR1_GPT1_SERIAL(n) ((uint32_t)(((n) & 0x03) << 22))
+#define CCM_CSCMR1_PERCLK_CLK_SEL ((uint32_t)(1 << 6)) // 0: F_BUS_ACTUAL, 1: 24MHz oscillator
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "sim.h"
+#include <cstdint>
+
+// Simulated Kinetis K timer peripherals (FTM, register layout: TeensyTimerTool::FTM_r_t)
+
+#define KINETISK
+#if !defined(F_CPU) // default clocks of Teensyduino
+    #if defined(ARDUINO_TEENSY36)
+        #define F_CPU 180000000
+    #elif defined(ARDUINO_TEENSY35)
+        #define F_CPU 120000000
+    #else
+        #define F_CPU 96000000
+    #endif
+#endif
+#if !defined(F_BUS)
+    #define F_BUS (F_CPU > 120000000 ? 60000000 : F_CPU / 2)
+#endif
+
+enum IRQ_NUMBER_t
+{
+#if defined(ARDUINO_TEENSY31) || defined(ARDUINO_TEENSY32)
+    IRQ_FTM0 = 62,
+    IRQ_FTM1 = 63,
+    IRQ_FTM2 = 64,
+#else
+    IRQ_FTM0 = 42,
+    IRQ_FTM1 = 43,
+    IRQ_FTM2 = 44,
+    IRQ_FTM3 = 71,
+#endif
+};
+
+#define FTM_SC_TOF 0x80
+#define FTM_SC_TOIE 0x40
+#define FTM_SC_CPWMS 0x20
+#define FTM_SC_CLKS(n) (((n) & 3) << 3)
+#define FTM_SC_CLKS_MASK 0x18
+#define FTM_SC_PS(n) (((n) & 7) << 0)
+#define FTM_SC_PS_MASK 0x07
+#define FTM_CSC_CHF 0x80
+#define FTM_CSC_CHIE 0x40
+#define FTM_CSC_MSB 0x20
+#define FTM_CSC_MSA 0x10
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Register level simulator of the Teensy timer peripherals
+//
+// The library is compiled unchanged against the headers in this folder. Its register blocks are
+// sim::Register objects; every access is charged to a virtual cpu cycle clock and routed to a model
+// of the peripheral owning the register. The models derive their counters from the virtual clock,
+// set the status flags and request the interrupts which are dispatched to the vectors registered
+// by attachInterruptVector().
+//
+// Only the timing of the bus accesses, the exception entry/exit and explicit calls to sim::spend()
+// is accounted for, the instructions of the compiled code don't take any virtual time. The numbers
+// are thus a lower bound of the real latency, but they are exact and deterministic.
+//
+// Virtual time: if sim::wakeup is set, the thread mode wait loop (delay(), sim::run()) doesn't spin
+// but jumps from one event to the next, i.e. to the next interrupt or to the time returned by wakeup(),
+// typically the next TCK deadline. Long runs (days of simulated time) only cost the time of the events.
+
+namespace sim
+{
+    constexpr uint64_t never = ~0ull;
+
+    struct Timing // cpu cycles
+    {
+        uint32_t busAccess;   // peripheral register read or write
+        uint32_t isrEntry;    // exception entry (stacking, vector fetch)
+        uint32_t isrExit;     // exception return
+        uint32_t counterRead; // ARM_DWT_CYCCNT, micros(), millis()
+        uint32_t delayLoop;   // one iteration of the yield loop in delay()
+    };
+    extern Timing timing;
+
+    uint64_t now();               // cpu cycles since start
+    void spend(uint64_t cycles);  // executes code for the given cycles, interrupts are taken in between
+    void runUntil(uint64_t cycle);
+    uint64_t irqEventTime();      // cycle at which the serviced interrupt was requested, now() outside of isrs
+    inline uint64_t irqLatency() { return now() - irqEventTime(); }
+
+    extern uint32_t (*wakeup)();                // virtual time: cycles until the thread code needs to run again, nullptr to spin
+    void run(uint64_t cycles, void (*loop)());  // calls loop() for the given cycles, like delay() calls yield()
+
+    uint32_t cycleCounter(); // ARM_DWT_CYCCNT
+    bool inIsr();
+    uint32_t primask();
+    void disableIrq();
+    void enableIrq();
+
+    // Base class of the peripheral models. A model owns the register block [regs, regs + size).
+    class Peripheral
+    {
+     public:
+        Peripheral(const volatile void* regs, size_t size, int irq);
+
+        virtual void sync(uint64_t now) = 0;              // update counters and flags up to (including) cycle now
+        virtual uint64_t nextEvent() = 0;                 // cycle of the next event after the last sync, never if none
+        virtual void write(void* reg, uint32_t value) = 0; // register write, the model is synced before
+        virtual bool irqRequest() = 0;                    // level of the interrupt line
+
+        bool owns(const volatile void* reg) const { return reg >= begin && reg < end; }
+        uint64_t requestTime() const { return eventTime; }
+        const int irq;
+        const unsigned nr; // index in the list of models
+
+     protected:
+        void signal(uint64_t cycle) { eventTime = cycle; } // call when a flag is set
+        const volatile uint8_t *begin, *end;
+        uint64_t eventTime = 0;
+    };
+
+    Peripheral* access(const volatile void* reg); // charges a bus access and syncs the owning model (if any)
+    void written(Peripheral* owner);              // takes the interrupts requested by a register write
+
+    // Peripheral register, accesses are forwarded to the owning model. Models use raw directly.
+    template <typename T>
+    struct Register
+    {
+        T raw;
+
+        operator T() const
+        {
+            access(this);
+            return raw;
+        }
+
+        Register& operator=(T value)
+        {
+            Peripheral* owner = access(this);
+            if (owner != nullptr)
+                owner->write(this, value);
+            else
+                raw = value;
+            written(owner);
+            return *this;
+        }
+
+        Register& operator|=(T value) { return *this = (T)(*this | value); } // read modify write, i.e., two bus accesses
+        Register& operator&=(T value) { return *this = (T)(*this & value); }
+        Register& operator^=(T value) { return *this = (T)(*this ^ value); }
+    };
+
+    // Peripheral clock derived from the cpu clock. Tick n ends at the first cpu cycle c with c*hz/F_CPU >= n
+    class Clock
+    {
+     public:
+        Clock(uint64_t hz = 0);
+
+        uint64_t tickAt(uint64_t cycle) const;  // ticks elapsed up to cycle
+        uint64_t cycleOf(uint64_t tick) const;  // first cycle at which tick has elapsed
+        uint64_t hz;
+
+     private:
+        uint64_t cyclesPerTick; // 0 if F_CPU is not a multiple of hz
+        int shift;              // log2(cyclesPerTick) if it is a power of two, -1 otherwise
+    };
+}
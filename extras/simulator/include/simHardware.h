@@ -0,0 +1,14 @@
+#pragma once
+
+#include "sim.h"
+
+// Picked up by src/Teensy/hardware.h, replaces the register types and cpu instructions of the library by the simulator
+
+namespace TeensyTimerTool
+{
+    using reg32_t = sim::Register<uint32_t>;
+
+    inline void dataSyncBarrier() { sim::spend(sim::timing.busAccess); } // waits for the last register write
+
+    inline uint32_t readPrimask() { return sim::primask(); }
+}
@@ -0,0 +1,344 @@
+#if defined(ARDUINO_TEENSY40) || defined(ARDUINO_TEENSY41)
+
+    #include "imxrt.h"
+    #include "sim.h"
+    #include <algorithm>
+
+// Register blocks ----------------------------------------------------------------------
+
+IMXRT_TMR_t IMXRT_TMR1, IMXRT_TMR2, IMXRT_TMR3, IMXRT_TMR4;
+IMXRT_PIT_CHANNEL_t IMXRT_PIT_CHANNELS[4];
+sim::Register<uint32_t> PIT_MCR;
+sim::Register<uint32_t> IMXRT_GPT1[10], IMXRT_GPT2[10];
+sim::Register<uint32_t> CCM_CCGR0, CCM_CCGR1, CCM_CSCMR1;
+
+namespace sim
+{
+    namespace
+    {
+        uint64_t perClock() { return (CCM_CSCMR1.raw & CCM_CSCMR1_PERCLK_CLK_SEL) ? 24'000'000 : F_BUS_ACTUAL; } // PIT and GPT
+
+        // QuadTimer ================================================================================
+        // Channels count up on the IP bus clock (CM=1, PCS=8..15) or on the compares of their source channel
+        // (cascade, CM=7, PCS=4..7). A compare sets TCF1, loads COMP1 from CMPLD1 (CL1=1), reinitializes the
+        // counter from LOAD (LENGTH) and stops counting (ONCE) until CTRL is written again. A cascaded pair
+        // is simulated as one 32bit counter which matches if both halves match.
+        class TmrModel : public Peripheral
+        {
+         public:
+            TmrModel(IMXRT_TMR_t* regs, int irq) : Peripheral(regs, sizeof(IMXRT_TMR_t), irq), regs(regs) {}
+
+            void sync(uint64_t now) override
+            {
+                for (Counter& c : counters)
+                {
+                    if (c.low == nullptr) continue;
+                    uint64_t tick = c.clock.tickAt(now);
+                    while (c.running && c.nextMatch() <= tick) match(c);
+                    c.store(c.valueAt(tick));
+                }
+            }
+
+            uint64_t nextEvent() override
+            {
+                uint64_t next = never;
+                for (Counter& c : counters)
+                    if (c.low != nullptr && c.running) next = std::min(next, c.clock.cycleOf(c.nextMatch()));
+                return next;
+            }
+
+            void write(void* reg, uint32_t value) override
+            {
+                unsigned nr = ((uint8_t*)reg - (uint8_t*)regs) / sizeof(IMXRT_TMR_CH_t);
+                IMXRT_TMR_CH_t& ch = regs->CH[nr];
+                Register<uint16_t>* r = (Register<uint16_t>*)reg;
+
+                if (r == &ch.CSCTRL) // TCF1 and TCF2 are cleared by writing 0
+                {
+                    uint16_t flags = TMR_CSCTRL_TCF1 | TMR_CSCTRL_TCF2;
+                    ch.CSCTRL.raw = (ch.CSCTRL.raw & value & flags) | (value & ~flags);
+                    return;
+                }
+
+                r->raw = value;
+                if (r == &ch.CTRL) stopped &= ~(1 << nr);
+                if (r == &ch.CTRL || r == &ch.CNTR) configure(nr);
+            }
+
+            bool irqRequest() override
+            {
+                for (IMXRT_TMR_CH_t& ch : regs->CH)
+                {
+                    uint16_t cs = ch.CSCTRL.raw;
+                    if ((cs & TMR_CSCTRL_TCF1 && cs & TMR_CSCTRL_TCF1EN) || (cs & TMR_CSCTRL_TCF2 && cs & TMR_CSCTRL_TCF2EN)) return true;
+                }
+                return false;
+            }
+
+         protected:
+            struct Counter // single channel (high = nullptr) or cascaded pair
+            {
+                IMXRT_TMR_CH_t *low = nullptr, *high = nullptr;
+                Clock clock;
+                bool running = false;
+                uint64_t t1 = 0, v1 = 0, prev = 0; // counter value v1 at tick t1, prev before t1
+
+                uint64_t modulus() const { return high ? 0x1'0000'0000 : 0x1'0000; }
+                uint64_t compare() const { return high ? (uint64_t)high->COMP1.raw << 16 | low->COMP1.raw : low->COMP1.raw; }
+                uint64_t load() const { return high ? (uint64_t)high->LOAD.raw << 16 | low->LOAD.raw : low->LOAD.raw; }
+
+                uint64_t nextMatch() const
+                {
+                    uint64_t cmp = compare();
+                    return t1 + (v1 <= cmp ? cmp - v1 : modulus() - v1 + cmp);
+                }
+
+                uint64_t valueAt(uint64_t tick) const
+                {
+                    if (tick < t1) return prev;
+                    return running ? (v1 + tick - t1) & (modulus() - 1) : v1;
+                }
+
+                void store(uint64_t value)
+                {
+                    low->CNTR.raw = (uint16_t)value;
+                    if (high) high->CNTR.raw = (uint16_t)(value >> 16);
+                }
+            };
+
+            void match(Counter& c)
+            {
+                uint64_t t = c.nextMatch();
+                uint64_t cmp = c.compare();
+                uint16_t ctrl = (c.high ? c.high : c.low)->CTRL.raw;
+
+                for (IMXRT_TMR_CH_t* ch : {c.low, c.high})
+                {
+                    if (ch == nullptr) continue;
+                    ch->CSCTRL.raw |= TMR_CSCTRL_TCF1;
+                    if ((ch->CSCTRL.raw & 0b11) == 1) ch->COMP1.raw = ch->CMPLD1.raw; // CL1=1
+                }
+                signal(c.clock.cycleOf(t));
+
+                c.prev = cmp;
+                c.t1 = t + 1;
+                c.v1 = (ctrl & TMR_CTRL_LENGTH) ? c.load() : (cmp + 1) % c.modulus();
+                if (ctrl & TMR_CTRL_ONCE)
+                {
+                    c.running = false;
+                    stopped |= channelMask(c);
+                }
+            }
+
+            unsigned channelMask(const Counter& c) const
+            {
+                return 1 << (c.low - regs->CH) | (c.high ? 1 << (c.high - regs->CH) : 0);
+            }
+
+            // rebuilds the counters affected by a write to CTRL or CNTR of channel nr, the CNTR registers are synced to now
+            void configure(unsigned nr)
+            {
+                for (unsigned lowNr = 0; lowNr < 4; lowNr++)
+                {
+                    Counter& c = counters[lowNr];
+                    Counter fresh;
+
+                    IMXRT_TMR_CH_t* ch = &regs->CH[lowNr];
+                    unsigned cm = ch->CTRL.raw >> 13, pcs = (ch->CTRL.raw >> 9) & 0xF;
+                    if (cm == 1 && pcs >= 8) // counters are keyed by the channel counting the bus clock
+                    {
+                        fresh.low = ch;
+                        fresh.clock = Clock(F_BUS_ACTUAL >> (pcs & 0b0111));
+                        for (IMXRT_TMR_CH_t& h : regs->CH)
+                            if ((h.CTRL.raw >> 13) == 7 && ((h.CTRL.raw >> 9) & 0xF) == (0b0100 | lowNr)) fresh.high = &h;
+                    }
+
+                    unsigned bit = 1 << nr;
+                    bool touched = (fresh.low && (channelMask(fresh) & bit)) || (c.low && (channelMask(c) & bit));
+                    if (!touched) continue; // keeps its state, e.g. a reinitialization pending from a compare in this tick
+
+                    c = fresh;
+                    if (c.low == nullptr) continue;
+                    c.t1 = c.clock.tickAt(now()) + 1;
+                    c.prev = c.high ? (uint64_t)c.high->CNTR.raw << 16 | ch->CNTR.raw : ch->CNTR.raw;
+                    c.running = !(stopped & channelMask(c));
+                    c.v1 = c.running ? (c.prev + 1) % c.modulus() : c.prev;
+                }
+            }
+
+            IMXRT_TMR_t* regs;
+            Counter counters[4];
+            unsigned stopped = 0; // channels stopped by ONCE
+        };
+
+        // PIT ======================================================================================
+        // Down counters, loaded from LDVAL when enabled and on each expiry which sets TIF. Chaining is not simulated.
+        class PitModel : public Peripheral
+        {
+         public:
+            PitModel() : Peripheral(IMXRT_PIT_CHANNELS, sizeof(IMXRT_PIT_CHANNELS), IRQ_PIT) {}
+
+            void sync(uint64_t now) override
+            {
+                for (unsigned nr = 0; nr < 4; nr++)
+                {
+                    State& s = state[nr];
+                    if (!s.running) continue;
+
+                    IMXRT_PIT_CHANNEL_t& ch = IMXRT_PIT_CHANNELS[nr];
+                    uint64_t tick = s.clock.tickAt(now);
+                    while (s.expiry <= tick)
+                    {
+                        ch.TFLG.raw = PIT_TFLG_TIF;
+                        signal(s.clock.cycleOf(s.expiry));
+                        s.expiry += ch.LDVAL.raw + 1ull;
+                    }
+                    ch.CVAL.raw = (uint32_t)(s.expiry - tick - 1);
+                }
+            }
+
+            uint64_t nextEvent() override
+            {
+                uint64_t next = never;
+                for (State& s : state)
+                    if (s.running) next = std::min(next, s.clock.cycleOf(s.expiry));
+                return next;
+            }
+
+            void write(void* reg, uint32_t value) override
+            {
+                unsigned nr = ((uint8_t*)reg - (uint8_t*)IMXRT_PIT_CHANNELS) / sizeof(IMXRT_PIT_CHANNEL_t);
+                IMXRT_PIT_CHANNEL_t& ch = IMXRT_PIT_CHANNELS[nr];
+                State& s = state[nr];
+
+                if (reg == &ch.TFLG) // write 1 to clear
+                {
+                    if (value & PIT_TFLG_TIF) ch.TFLG.raw = 0;
+                } else if (reg == &ch.TCTRL)
+                {
+                    bool enable = value & PIT_TCTRL_TEN;
+                    if (enable && !s.running)
+                    {
+                        s.clock = Clock(perClock());
+                        s.expiry = s.clock.tickAt(now()) + ch.LDVAL.raw + 1;
+                        ch.CVAL.raw = ch.LDVAL.raw;
+                    }
+                    s.running = enable;
+                    ch.TCTRL.raw = value;
+                } else if (reg == &ch.LDVAL) // a running timer loads the new value on expiry
+                    ch.LDVAL.raw = value;
+            }
+
+            bool irqRequest() override
+            {
+                for (IMXRT_PIT_CHANNEL_t& ch : IMXRT_PIT_CHANNELS)
+                    if ((ch.TFLG.raw & PIT_TFLG_TIF) && (ch.TCTRL.raw & PIT_TCTRL_TIE)) return true;
+                return false;
+            }
+
+         protected:
+            struct State
+            {
+                bool running = false;
+                Clock clock;
+                uint64_t expiry = 0; // tick
+            } state[4];
+        };
+
+        // GPT ======================================================================================
+        // Up counter on the peripheral clock (CLKSRC=1) or the 24MHz oscillator (CLKSRC=4), divided by PR+1.
+        // A match with OCR1 sets OF1. In restart mode (FRR=0) the counter restarts at 0 after the match and
+        // on each write to OCR1. Enabling resets the counter if ENMOD is set.
+        class GptModel : public Peripheral
+        {
+         public:
+            GptModel(Register<uint32_t>* regs, int irq) : Peripheral(regs, 10 * sizeof(Register<uint32_t>), irq), r(regs) {}
+
+            void sync(uint64_t now) override
+            {
+                if (!running) return;
+
+                uint64_t tick = clock.tickAt(now);
+                while (match <= tick)
+                {
+                    r[SR].raw |= GPT_SR_OF1;
+                    signal(clock.cycleOf(match));
+                    if (r[CR].raw & GPT_CR_FRR)
+                        match += 0x1'0000'0000;
+                    else
+                    {
+                        base = match + 1;
+                        match = base + r[OCR1].raw;
+                    }
+                }
+                r[CNT].raw = tick < base ? r[OCR1].raw : (uint32_t)(tick - base); // tick < base: the match tick
+            }
+
+            uint64_t nextEvent() override { return running ? clock.cycleOf(match) : never; }
+
+            void write(void* reg, uint32_t value) override
+            {
+                unsigned idx = (Register<uint32_t>*)reg - r;
+                uint64_t tick = clock.hz != 0 ? clock.tickAt(now()) : 0;
+
+                switch (idx)
+                {
+                    case CR:
+                    {
+                        bool enable = value & GPT_CR_EN;
+                        r[CR].raw = value;
+                        if (enable && !running)
+                        {
+                            unsigned src = (value >> 6) & 0b111;
+                            uint64_t hz = src == 1 ? perClock() : src == 4 ? 24'000'000 : 0;
+                            if (hz == 0) break; // clock source not simulated
+                            clock = Clock(hz / ((r[PR].raw & 0xFFF) + 1));
+                            tick = clock.tickAt(now());
+                            base = tick - ((value & GPT_CR_ENMOD) ? 0 : r[CNT].raw);
+                            setMatch(tick);
+                            running = true;
+                        } else if (!enable)
+                            running = false;
+                        break;
+                    }
+                    case SR: // write 1 to clear
+                        r[SR].raw &= ~(value & 0x3F);
+                        break;
+                    case OCR1:
+                        r[OCR1].raw = value;
+                        if (!running) break;
+                        if (!(r[CR].raw & GPT_CR_FRR)) base = tick; // restart mode
+                        setMatch(tick);
+                        break;
+                    case CNT:
+                        break; // read only
+                    default:
+                        r[idx].raw = value;
+                        break;
+                }
+            }
+
+            bool irqRequest() override { return r[SR].raw & r[IR].raw & 0x3F; }
+
+         protected:
+            enum : unsigned { CR = 0, PR, SR, IR, OCR1, OCR2, OCR3, ICR1, ICR2, CNT }; // see IMXRT_GPT_t
+
+            void setMatch(uint64_t tick) // first tick >= tick at which the counter equals OCR1
+            {
+                match = base + r[OCR1].raw;
+                while (match < tick) match += 0x1'0000'0000;
+            }
+
+            Register<uint32_t>* r;
+            Clock clock;
+            bool running = false;
+            uint64_t base = 0, match = 0; // counter is 0 at tick base
+        };
+
+        TmrModel tmr1(&IMXRT_TMR1, IRQ_QTIMER1), tmr2(&IMXRT_TMR2, IRQ_QTIMER2), tmr3(&IMXRT_TMR3, IRQ_QTIMER3), tmr4(&IMXRT_TMR4, IRQ_QTIMER4);
+        PitModel pit;
+        GptModel gpt1(IMXRT_GPT1, IRQ_GPT1), gpt2(IMXRT_GPT2, IRQ_GPT2);
+    }
+}
+
+#endif
@@ -0,0 +1,172 @@
+#if defined(ARDUINO_TEENSY30) || defined(ARDUINO_TEENSY31) || defined(ARDUINO_TEENSY32) || defined(ARDUINO_TEENSY35) || defined(ARDUINO_TEENSY36)
+
+    #include "core_pins.h"
+    #include "config.h"
+    #include "Teensy/FTM/FTM_Info.h"
+    #include <algorithm>
+    #include <cstdio>
+    #include <cstdlib>
+    #include <sys/mman.h>
+
+namespace sim
+{
+    namespace
+    {
+        using TeensyTimerTool::FTM_Info;
+        using TeensyTimerTool::FTM_r_t;
+
+        // The library accesses the FTM register blocks at their fixed hardware addresses
+        FTM_r_t* mapRegisters(uintptr_t adr)
+        {
+            void* page = (void*)(adr & ~0xFFFul);
+            void* p = mmap(page, 0x1000, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+            if (p != page)
+            {
+                fprintf(stderr, "sim: can't map the FTM registers at 0x%08lx\n", (unsigned long)adr);
+                exit(1);
+            }
+            return (FTM_r_t*)adr;
+        }
+
+        // FTM ======================================================================================
+        // Up counter from 0 to MOD on the bus clock (CLKS=1) divided by 2^PS, a write to CNT restarts at 0.
+        // CHF of a channel is set whenever the counter equals CV, independent of CHIE. CV writes take effect
+        // with the next counter tick. CHF is cleared by writing 0 to CnSC or STATUS. Overflows (TOF) are not simulated.
+        class FtmModel : public Peripheral
+        {
+         public:
+            FtmModel(uintptr_t adr, unsigned nrOfChannels, int irq)
+                : Peripheral((void*)adr, sizeof(FTM_r_t), irq), r(mapRegisters(adr)), nrOfChannels(nrOfChannels) {}
+
+            void sync(uint64_t now) override
+            {
+                if (!running) return;
+
+                uint64_t tick = clock.tickAt(now);
+                for (unsigned nr = 0; nr < nrOfChannels; nr++)
+                {
+                    uint64_t t = nextMatch(nr);
+                    if (t > tick) continue;
+                    r->CH[nr].SC.raw |= FTM_CSC_CHF; // missed matches only leave the flag set
+                    signal(clock.cycleOf(t));
+                }
+                last = tick;
+                r->CNT.raw = (tick - base) % modulus();
+                updateStatus();
+            }
+
+            uint64_t nextEvent() override
+            {
+                if (!running) return never;
+
+                uint64_t next = never;
+                for (unsigned nr = 0; nr < nrOfChannels; nr++) next = std::min(next, nextMatch(nr));
+                return next == never ? never : clock.cycleOf(next);
+            }
+
+            void write(void* reg, uint32_t value) override
+            {
+                uint64_t tick = running ? clock.tickAt(now()) : 0;
+
+                if (reg == &r->SC)
+                {
+                    r->SC.raw = value;
+                    unsigned clks = (value & FTM_SC_CLKS_MASK) >> 3;
+                    running = clks == 1;
+                    if (!running) return; // fixed frequency and external clocks are not simulated
+
+                    clock = Clock(F_BUS >> (value & FTM_SC_PS_MASK));
+                    last = clock.tickAt(now());
+                    base = last - r->CNT.raw; // continue counting
+                } else if (reg == &r->CNT) // any write restarts the counter
+                {
+                    r->CNT.raw = 0;
+                    base = last = tick;
+                } else if (reg == &r->MOD)
+                {
+                    r->MOD.raw = value & 0xFFFF;
+                } else if (reg == &r->STATUS) // writing 0 clears the flag
+                {
+                    for (unsigned nr = 0; nr < nrOfChannels; nr++)
+                        if (!(value & (1 << nr))) r->CH[nr].SC.raw &= ~FTM_CSC_CHF;
+                    updateStatus();
+                } else
+                {
+                    for (unsigned nr = 0; nr < nrOfChannels; nr++)
+                    {
+                        if (reg == &r->CH[nr].SC)
+                        {
+                            uint32_t chf = r->CH[nr].SC.raw & value & FTM_CSC_CHF;
+                            r->CH[nr].SC.raw = chf | (value & ~FTM_CSC_CHF);
+                            updateStatus();
+                            return;
+                        }
+                        if (reg == &r->CH[nr].CV)
+                        {
+                            r->CH[nr].CV.raw = value & 0xFFFF;
+                            matchFrom[nr] = running ? tick + 1 : 0; // buffered until the counter changes
+                            return;
+                        }
+                    }
+                    ((Register<uint32_t>*)reg)->raw = value;
+                }
+            }
+
+            bool irqRequest() override
+            {
+                for (unsigned nr = 0; nr < nrOfChannels; nr++)
+                {
+                    uint32_t sc = r->CH[nr].SC.raw;
+                    if ((sc & FTM_CSC_CHF) && (sc & FTM_CSC_CHIE)) return true;
+                }
+                return false;
+            }
+
+         protected:
+            uint64_t modulus() const { return (r->MOD.raw & 0xFFFF) + 1; }
+
+            uint64_t nextMatch(unsigned nr) const // first tick after the last sync at which the counter equals CV
+            {
+                uint64_t cv = r->CH[nr].CV.raw, m = modulus();
+                if (cv >= m) return never;
+
+                uint64_t from = std::max(last + 1, matchFrom[nr]);
+                uint64_t t = base + cv;
+                if (t < from) t += (from - t + m - 1) / m * m;
+                return t;
+            }
+
+            void updateStatus()
+            {
+                uint32_t status = 0;
+                for (unsigned nr = 0; nr < nrOfChannels; nr++)
+                    if (r->CH[nr].SC.raw & FTM_CSC_CHF) status |= 1 << nr;
+                r->STATUS.raw = status;
+            }
+
+            FTM_r_t* r;
+            const unsigned nrOfChannels;
+            Clock clock;
+            bool running = false;
+            uint64_t base = 0, last = 0; // counter is 0 at tick base, matches up to tick last are processed
+            uint64_t matchFrom[8] = {};
+        };
+
+        template <unsigned m>
+        struct Ftm : FtmModel
+        {
+            Ftm() : FtmModel(FTM_Info<m>::baseAdr, FTM_Info<m>::nrOfChannels, FTM_Info<m>::irqNumber) {}
+        };
+
+        Ftm<0> ftm0;
+        Ftm<1> ftm1;
+    #if defined(ARDUINO_TEENSY31) || defined(ARDUINO_TEENSY32) || defined(ARDUINO_TEENSY35) || defined(ARDUINO_TEENSY36)
+        Ftm<2> ftm2;
+    #endif
+    #if defined(ARDUINO_TEENSY35) || defined(ARDUINO_TEENSY36)
+        Ftm<3> ftm3;
+    #endif
+    }
+}
+
+#endif
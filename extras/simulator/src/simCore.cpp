@@ -0,0 +1,285 @@
+#include "Arduino.h"
+#include "sim.h"
+#include <algorithm>
+#include <cstdarg>
+#include <vector>
+
+namespace sim
+{
+#if defined(F_BUS_ACTUAL)
+    constexpr uint32_t busClock = F_BUS_ACTUAL;
+#else
+    constexpr uint32_t busClock = F_BUS;
+#endif
+
+    Timing timing = {
+        F_CPU / busClock, // busAccess: one bus clock, lower bound
+        12,               // isrEntry, Cortex-M4/M7 without wait states
+        10,               // isrExit
+        1,                // counterRead
+        100,              // delayLoop
+    };
+
+    uint32_t (*wakeup)() = nullptr;
+
+    namespace
+    {
+        uint64_t cycles = 0;
+        uint32_t primaskValue = 0;
+        bool handlerMode = false;
+        uint64_t serviced = 0; // request time of the interrupt being serviced
+
+        void (*vectors[256])();
+        bool enabled[256];
+
+        // The next event and the interrupt request of a model only change when it processes an event or when one of
+        // its registers is written. Both are cached, time steps without events are O(1).
+        struct Model
+        {
+            Peripheral* p;
+            uint64_t next;
+            bool request;
+            bool stale;
+        };
+
+        std::vector<Model>& models() // function local, models register from static constructors in other units
+        {
+            static std::vector<Model> list;
+            return list;
+        }
+
+        bool dirty = true;           // some model is stale
+        uint64_t nextAt;             // earliest event of all models
+        Peripheral* nextPeripheral;  // its model
+        bool requested;              // some enabled interrupt is requested
+
+        void invalidate(Peripheral* p)
+        {
+            models()[p->nr].stale = true;
+            dirty = true;
+        }
+
+        void invalidateAll()
+        {
+            for (Model& m : models()) m.stale = true;
+            dirty = true;
+        }
+
+        void refresh()
+        {
+            if (!dirty) return;
+            dirty = false;
+            nextAt = never;
+            nextPeripheral = nullptr;
+            requested = false;
+            for (Model& m : models())
+            {
+                if (m.stale)
+                {
+                    m.stale = false;
+                    m.next = m.p->nextEvent();
+                    m.request = enabled[m.p->irq] && vectors[m.p->irq] != nullptr && m.p->irqRequest();
+                }
+                if (m.next < nextAt)
+                {
+                    nextAt = m.next;
+                    nextPeripheral = m.p;
+                }
+                requested |= m.request;
+            }
+        }
+
+        // highest priority (lowest number) enabled interrupt requested by a model, nullptr if none
+        Peripheral* pendingIrq()
+        {
+            Peripheral* pending = nullptr;
+            for (Model& m : models())
+            {
+                Peripheral* p = m.p;
+                if (m.request && (pending == nullptr || p->irq < pending->irq || (p->irq == pending->irq && p->requestTime() < pending->requestTime())))
+                    pending = p;
+            }
+            return pending;
+        }
+
+        bool advance(uint64_t target, bool untilIrq = false);
+
+        // interrupt lines are level sensitive, an isr which doesn't clear its flag is entered again
+        bool takeInterrupts()
+        {
+            if (handlerMode || primaskValue != 0) return false;
+
+            bool taken = false;
+            Peripheral* p;
+            while (refresh(), requested && (p = pendingIrq()) != nullptr)
+            {
+                handlerMode = true;
+                serviced = p->requestTime();
+                advance(cycles + timing.isrEntry);
+                vectors[p->irq]();
+                advance(cycles + timing.isrExit);
+                handlerMode = false;
+                taken = true;
+            }
+            return taken;
+        }
+
+        // processes the peripheral events up to target in order, interrupts are taken when they occur.
+        // With untilIrq it returns early (true) after an interrupt was taken
+        bool advance(uint64_t target, bool untilIrq)
+        {
+            while (refresh(), nextPeripheral != nullptr && nextAt <= target)
+            {
+                if (nextAt > cycles) cycles = nextAt;
+                nextPeripheral->sync(cycles);
+                invalidate(nextPeripheral);
+                if (takeInterrupts() && untilIrq) return true;
+            }
+            if (target > cycles) cycles = target;
+            return false;
+        }
+    }
+
+    uint64_t now() { return cycles; }
+    void spend(uint64_t c) { advance(cycles + c); }
+    void runUntil(uint64_t cycle) { advance(cycle); }
+    uint64_t irqEventTime() { return handlerMode ? serviced : cycles; }
+    bool inIsr() { return handlerMode; }
+    uint32_t primask() { return primaskValue; }
+    void disableIrq() { primaskValue = 1; }
+
+    void enableIrq()
+    {
+        primaskValue = 0;
+        takeInterrupts(); // requests pending while disabled
+    }
+
+    void run(uint64_t duration, void (*loop)())
+    {
+        uint64_t end = cycles + duration;
+        while (cycles < end)
+        {
+            loop();
+            if (wakeup == nullptr)
+                spend(timing.delayLoop);
+            else // an isr might start a TCK timer which is due before the wakeup time, re-evaluate after each one
+                advance(std::min(end, cycles + std::max<uint64_t>(wakeup(), 1)), true);
+        }
+    }
+
+    uint32_t cycleCounter()
+    {
+        spend(timing.counterRead);
+        return (uint32_t)cycles;
+    }
+
+    void written(Peripheral* owner) // the write might have changed the events or enabled an interrupt
+    {
+        if (owner != nullptr)
+            invalidate(owner);
+        else
+            invalidateAll(); // e.g. a clock gate or a clock source
+        takeInterrupts();
+    }
+
+    Peripheral* access(const volatile void* reg)
+    {
+        spend(timing.busAccess);
+        for (Model& m : models())
+        {
+            if (m.p->owns(reg))
+            {
+                m.p->sync(cycles);
+                return m.p;
+            }
+        }
+        return nullptr;
+    }
+
+    Peripheral::Peripheral(const volatile void* regs, size_t size, int irq)
+        : irq(irq), nr(models().size()), begin((const volatile uint8_t*)regs), end((const volatile uint8_t*)regs + size)
+    {
+        models().push_back({this, never, false, true});
+        dirty = true;
+    }
+
+    Clock::Clock(uint64_t hz)
+        : hz(hz), cyclesPerTick(hz != 0 && F_CPU % hz == 0 ? F_CPU / hz : 0), shift(-1)
+    {
+        if (cyclesPerTick != 0 && (cyclesPerTick & (cyclesPerTick - 1)) == 0) shift = __builtin_ctzll(cyclesPerTick);
+    }
+
+    uint64_t Clock::tickAt(uint64_t cycle) const
+    {
+        if (shift >= 0) return cycle >> shift;
+        if (cyclesPerTick != 0) return cycle / cyclesPerTick;
+        return (unsigned __int128)cycle * hz / F_CPU;
+    }
+
+    uint64_t Clock::cycleOf(uint64_t tick) const
+    {
+        if (cyclesPerTick != 0) return tick * cyclesPerTick;
+        return ((unsigned __int128)tick * F_CPU + hz - 1) / hz;
+    }
+}
+
+// Teensyduino core ---------------------------------------------------------------------
+
+volatile uint32_t ARM_DEMCR, ARM_DWT_CTRL;
+
+void attachInterruptVector(IRQ_NUMBER_t irq, void (*function)(void))
+{
+    sim::vectors[irq] = function;
+    sim::written(nullptr);
+}
+
+void nvicEnable(IRQ_NUMBER_t irq, bool enable)
+{
+    sim::enabled[irq] = enable;
+    sim::written(nullptr);
+}
+
+uint32_t micros()
+{
+    sim::spend(sim::timing.counterRead);
+    return sim::now() / (F_CPU / 1'000'000);
+}
+
+uint32_t millis()
+{
+    sim::spend(sim::timing.counterRead);
+    return sim::now() / (F_CPU / 1'000);
+}
+
+void delay(uint32_t ms) { sim::run((uint64_t)ms * (F_CPU / 1'000), yield); }
+
+__attribute__((weak)) void yield() {} // core default, the library replaces it unless YIELD_TYPE is YIELD_NONE
+
+void delayMicroseconds(uint32_t us) { sim::spend((uint64_t)us * (F_CPU / 1'000'000)); }
+
+void pinMode(uint8_t, uint8_t) {}
+void digitalWriteFast(uint8_t, uint8_t) {}
+uint8_t digitalReadFast(uint8_t) { return 0; }
+void digitalToggleFast(uint8_t) {}
+
+int Stream::printf(const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int n = vprintf(format, args);
+    va_end(args);
+    return n;
+}
+
+Stream Serial;
+void serialEvent() {}
+
+#if defined(KINETISK) || defined(KINETISL)
+Stream Serial1, Serial2, Serial3;
+void serialEvent1() {}
+void serialEvent2() {}
+void serialEvent3() {}
+#else
+bool HardwareSerial::serial_event_handlers_active = false;
+uint8_t usb_enable_serial_event_processing = 0;
+#endif
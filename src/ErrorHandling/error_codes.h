@@ -34,5 +34,8 @@ namespace TeensyTimerTool
         //TCK Errors
         TCK_err =          900,
         TCK_err2 =         901,
+
+        //HOST Errors
+        HOST_timerfd =    1000, // timerfd_create failed, e.g. out of file descriptors
     };
 }
\ No newline at end of file
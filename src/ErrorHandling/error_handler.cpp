@@ -1,9 +1,13 @@
-#include "error_handler.h"
-#include "core_pins.h"
 #include "types.h"
 
+#if defined(TEENSYDUINO)
+    #include "error_handler.h"
+    #include "core_pins.h"
+#endif
+
 namespace TeensyTimerTool
 {
+#if defined(TEENSYDUINO) // the default handler prints to a Stream and blinks the LED, not available on the Linux host
     ErrorHandler::ErrorHandler(Stream& s) : stream(s)
     {
         pinMode(LED_BUILTIN, OUTPUT);
@@ -59,6 +63,7 @@ namespace TeensyTimerTool
             delay(50);
         }
     }
+#endif
 
     errorFunc_t errFunc;
 
@@ -1,39 +1,56 @@
 #pragma once
 
+#include "channelCallback.h"
 #include "types.h"
 
+#if defined(ENABLE_TIMER_STATS)
+    #include "timerStats.h"
+#endif
+
 namespace TeensyTimerTool
 {
     class ITimerChannel
     {
      public:
-        virtual errorCode begin(callback_t callback, uint32_t period, bool oneShot) = 0;
-        virtual errorCode begin(callback_t callback, float period, bool oneShot) { return postError(errorCode::wrongType); };
+        virtual errorCode begin(ChannelCallback callback, uint32_t period, bool oneShot) = 0;
+        virtual errorCode begin(ChannelCallback callback, float period, bool oneShot) { return postError(errorCode::wrongType); };
         virtual errorCode trigger(uint32_t delay) = 0;
         virtual errorCode trigger(float delay) { return postError(errorCode::wrongType); }
 
+        // raw timer ticks, e.g. to retrigger with a delay converted once by ticksFromMicros() / ticksFromNanos()
+        virtual errorCode beginTicks(ChannelCallback callback, uint64_t ticks, bool periodic) { return postError(errorCode::notImplemented); }
+        virtual errorCode triggerTicks(uint64_t ticks) { return postError(errorCode::notImplemented); }
+        virtual uint64_t ticksFromMicros(uint32_t micros) { postError(errorCode::notImplemented); return 0; }
+        virtual uint64_t ticksFromMicros(float micros) { postError(errorCode::notImplemented); return 0; }
+        virtual uint64_t ticksFromNanos(uint64_t nanos) { postError(errorCode::notImplemented); return 0; }
+        virtual errorCode setPeriodTicks(uint64_t ticks) { return postError(errorCode::notImplemented); } // new period starts at the next reload
+
         virtual float getMaxPeriod(){ postError(errorCode::notImplemented); return 0;};
 
-        virtual void setPeriod(uint32_t microSeconds);
-        virtual uint32_t getPeriod() { return 0; }
+        virtual void setPeriod(uint32_t microSeconds) { setPeriodTicks(ticksFromMicros(microSeconds)); }
+        virtual uint32_t getPeriod() { return 0; } // µs
 
         virtual void start(){};
         virtual errorCode stop() { return errorCode::OK; }
-        inline void setCallback(callback_t);
+        inline void setCallback(ChannelCallback);
+
+#if defined(ENABLE_TIMER_STATS)
+        TimerStats stats; // written by the isr / TCK dispatcher, read with BaseTimer::getStats()
+#endif
 
      protected:
-        inline ITimerChannel(callback_t* cbStorage = nullptr);
-        callback_t* pCallback;
+        inline ITimerChannel(ChannelCallback* cbStorage = nullptr);
+        ChannelCallback* pCallback;
     };
 
     // IMPLEMENTATION ====================================================
 
-    ITimerChannel::ITimerChannel(callback_t* cbStorage)
+    ITimerChannel::ITimerChannel(ChannelCallback* cbStorage)
     {
         this->pCallback = cbStorage;
     }
 
-    void ITimerChannel::setCallback(callback_t cb)
+    void ITimerChannel::setCallback(ChannelCallback cb)
     {
         *pCallback = cb;
     }
@@ -0,0 +1,169 @@
+#include "../config.h"
+
+#if defined(__linux__) && !defined(TEENSYDUINO)
+
+    #include "HOST.h"
+    #include <sys/timerfd.h>
+    #include <thread>
+    #include <time.h>
+    #include <unistd.h>
+
+namespace TeensyTimerTool
+{
+    std::mutex HOST_t::lock;
+    int HOST_t::timerFd = -1;
+    HostChannel HOST_t::channels[NR_OF_TCK_TIMERS];
+    uint32_t HOST_t::missed = 0;
+
+    ITimerChannel* HOST_t::getTimer()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (timerFd < 0 && init() != errorCode::OK) return nullptr; // begin() fails, init is retried with the next channel
+
+        for (HostChannel& channel : channels)
+        {
+            if (!channel.isAllocated)
+            {
+                channel.isAllocated = true;
+                return &channel;
+            }
+        }
+        return nullptr;
+    }
+
+    uint32_t HOST_t::ticksUntilDue()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        uint64_t next = ~0ull;
+        for (HostChannel& channel : channels)
+        {
+            if (channel.isActive && channel.deadline < next) next = channel.deadline;
+        }
+        uint64_t t = now();
+        if (next <= t) return 0;
+        return next - t > 0xFFFF'FFFF ? 0xFFFF'FFFF : (uint32_t)(next - t);
+    }
+
+    errorCode HOST_t::init()
+    {
+        timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+        if (timerFd < 0) return postError(errorCode::HOST_timerfd); // no dispatcher without a timerfd to wait on
+
+        std::thread(dispatch).detach();
+        return errorCode::OK;
+    }
+
+    uint64_t HOST_t::now()
+    {
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ts.tv_sec * 1'000'000'000ull + ts.tv_nsec;
+    }
+
+    void HOST_t::dispatch()
+    {
+        while (true)
+        {
+            uint64_t expirations;
+            if (read(timerFd, &expirations, sizeof(expirations)) != sizeof(expirations)) continue; // interrupted
+
+            std::unique_lock<std::mutex> guard(lock);
+            HostChannel* channel;
+            while ((channel = nextDue(now())) != nullptr)
+            {
+                ChannelCallback callback = channel->callback; // channel might be changed by other threads during the callback
+                guard.unlock();
+                if (callback != nullptr) callback();
+                guard.lock();
+            }
+            arm();
+        }
+    }
+
+    // earliest expired channel, restarts periodic channels and deactivates one shot channels. Call with lock held
+    HostChannel* HOST_t::nextDue(uint64_t now)
+    {
+        HostChannel* due = nullptr;
+        for (HostChannel& channel : channels)
+        {
+            if (channel.isActive && channel.deadline <= now && (due == nullptr || channel.deadline < due->deadline))
+                due = &channel;
+        }
+        if (due == nullptr) return nullptr;
+
+        if (due->isPeriodic && due->period != 0)
+        {
+            missed = (now - due->deadline) / due->period;
+            due->deadline += (missed + 1ull) * due->period;
+        } else
+        {
+            missed = 0;
+            due->isActive = false;
+        }
+        return due;
+    }
+
+    void HOST_t::arm()
+    {
+        uint64_t next = 0;
+        for (HostChannel& channel : channels)
+        {
+            if (channel.isActive && (next == 0 || channel.deadline < next)) next = channel.deadline;
+        }
+
+        itimerspec its{}; // all zero: disarm
+        if (next != 0)
+        {
+            its.it_value.tv_sec = next / 1'000'000'000;
+            its.it_value.tv_nsec = next % 1'000'000'000;
+        }
+        timerfd_settime(timerFd, TFD_TIMER_ABSTIME, &its, nullptr);
+    }
+
+    // HostChannel =====================================================================
+
+    errorCode HostChannel::beginTicks(ChannelCallback cb, uint64_t ticks, bool periodic)
+    {
+        std::lock_guard<std::mutex> guard(HOST_t::lock);
+        isActive = false;
+        isPeriodic = periodic;
+        period = ticks;
+        callback = cb;
+        HOST_t::arm();
+        return errorCode::OK;
+    }
+
+    void HostChannel::start()
+    {
+        std::lock_guard<std::mutex> guard(HOST_t::lock);
+        deadline = HOST_t::now() + period;
+        isActive = true;
+        HOST_t::arm();
+    }
+
+    errorCode HostChannel::stop()
+    {
+        std::lock_guard<std::mutex> guard(HOST_t::lock);
+        isActive = false;
+        HOST_t::arm();
+        return errorCode::OK;
+    }
+
+    errorCode HostChannel::triggerTicks(uint64_t ticks)
+    {
+        std::lock_guard<std::mutex> guard(HOST_t::lock);
+        deadline = HOST_t::now() + ticks;
+        isActive = true;
+        HOST_t::arm();
+        return errorCode::OK;
+    }
+
+    errorCode HostChannel::setPeriodTicks(uint64_t ticks)
+    {
+        std::lock_guard<std::mutex> guard(HOST_t::lock);
+        period = ticks; // used from the next expiry on, like the reload registers of the hardware timers
+        return errorCode::OK;
+    }
+}
+
+#endif
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "HostChannel.h"
+#include "config.h"
+#include <mutex>
+
+namespace TeensyTimerTool
+{
+    // Timer backend for Linux hosts (e.g. to run timer driven application code in CI or under perf).
+    //
+    // All channels share one timerfd which is armed to the earliest deadline (CLOCK_MONOTONIC, absolute).
+    // A dispatcher thread, started with the first channel, waits on the timerfd and invokes the due callbacks
+    // in deadline order. Periodic channels are phase locked, periods missed by a late dispatch are dropped and
+    // can be read from missedPeriods() in the callback (same as TCK_COALESCE).
+    // Channels are statically allocated, NR_OF_TCK_TIMERS of them are available.
+
+    class HOST_t
+    {
+     public:
+        static ITimerChannel* getTimer();
+        static void tick() {} // callbacks are invoked by the dispatcher thread, nothing to do
+        static uint32_t missedPeriods() { return missed; }
+        static uint32_t ticksUntilDue(); // ns until the earliest deadline
+        static uint64_t now(); // CLOCK_MONOTONIC, ns
+
+     protected:
+        static errorCode init(); // creates the timerfd and starts the dispatcher
+        static void dispatch(); // dispatcher thread
+        static HostChannel* nextDue(uint64_t now);
+        static void arm(); // call with lock held
+
+        static std::mutex lock;
+        static int timerFd;
+        static HostChannel channels[NR_OF_TCK_TIMERS];
+        static uint32_t missed;
+
+        friend HostChannel;
+    };
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "../ITimerChannel.h"
+#include "ErrorHandling/error_codes.h"
+
+namespace TeensyTimerTool
+{
+    class HOST_t;
+
+    // Software timer channel of the Linux host backend. Ticks are CLOCK_MONOTONIC nanoseconds,
+    // the callbacks are invoked from the dispatcher thread of HOST_t (i.e., like from an isr).
+    class HostChannel : public ITimerChannel
+    {
+     public:
+        HostChannel() : ITimerChannel(nullptr) {}
+
+        errorCode begin(ChannelCallback cb, uint32_t period, bool periodic) override { return beginTicks(cb, ticksFromMicros(period), periodic); }
+        errorCode begin(ChannelCallback cb, float period, bool periodic) override { return beginTicks(cb, ticksFromMicros(period), periodic); }
+        void start() override;
+        errorCode stop() override;
+
+        errorCode trigger(uint32_t delay) override { return triggerTicks(ticksFromMicros(delay)); } // µs
+        errorCode trigger(float delay) override { return triggerTicks(ticksFromMicros(delay)); }    // µs
+
+        errorCode beginTicks(ChannelCallback cb, uint64_t ticks, bool periodic) override;
+        errorCode triggerTicks(uint64_t ticks) override;
+        uint64_t ticksFromMicros(uint32_t micros) override { return micros * 1000ull; }
+        uint64_t ticksFromMicros(float micros) override { return micros * 1000.0; }
+        uint64_t ticksFromNanos(uint64_t nanos) override { return nanos; }
+
+        errorCode setPeriodTicks(uint64_t ticks) override;
+        uint32_t getPeriod() override { return period / 1000; }
+        float getMaxPeriod() override { return 0xFFFF'FFFF'FFFF'FFFF / 1E9f; } // s
+
+     protected:
+        uint64_t deadline = 0, period = 0; // ns
+        ChannelCallback callback;
+        bool isPeriodic = false;
+        bool isActive = false;
+        bool isAllocated = false;
+
+        friend HOST_t;
+    };
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace TeensyTimerTool
+{
+    // Statically reserved memory for the channel objects of a timer module. The objects are constructed
+    // when the channel is handed out (i.e., after the module is initialized) but never touch the heap.
+    // The memory shows up in the linker map.
+
+    template <typename T, unsigned N>
+    class ChannelStorage
+    {
+     public:
+        template <typename... Args>
+        inline T* construct(unsigned nr, Args&&... args) { return new (slots[nr]) T(std::forward<Args>(args)...); }
+        inline void destroy(T* channel) { channel->~T(); }
+
+     protected:
+        alignas(T) uint8_t slots[N][sizeof(T)];
+    };
+}
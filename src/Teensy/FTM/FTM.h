@@ -1,4 +1,5 @@
 #pragma once
+#include "../ChannelStorage.h"
 #include "FTM_Channel.h"
 #include "FTM_Info.h"
 
@@ -11,13 +12,29 @@ namespace TeensyTimerTool
         inline static ITimerChannel* getTimer();
         FTM_t() = delete;
 
+        template <unsigned chNr, void (*handler)()>
+        inline static ITimerChannel* getStaticTimer(); // channel chNr, serviced by a dedicated isr which calls handler directly
+
+        static constexpr uint64_t clockHz = F_BUS >> FTM_Info<moduleNr>::prescale; // for compile time conversion of ConstDurations
+        static constexpr uint64_t maxTicks = 0xFFFF'FFFF; // periods > 0xFFFF ticks are extended in software
+
      private:
         static bool isInitialized;
+        static bool hasStaticIsr;
+        static uint32_t allocated; // channels handed out by getTimer (one bit per channel), serviced by isr()
+        inline static void init();
         inline static void isr() FASTRUN;
+        inline static bool nextCompare(FTM_ChannelInfo* ci) FASTRUN;
+#if defined(ENABLE_TIMER_STATS)
+        inline static void recordOverrun(FTM_ChannelInfo* ci);
+#endif
+        template <unsigned chNr, void (*handler)()>
+        inline static void staticIsr() FASTRUN;
 
-        static constexpr FTM_r_t* r = (FTM_r_t*)FTM_Info<moduleNr>::baseAdr;
+        static FTM_r_t* const r;
         static constexpr unsigned maxChannel = FTM_Info<moduleNr>::nrOfChannels;
         static FTM_ChannelInfo channelInfo[maxChannel];
+        static ChannelStorage<FTM_Channel, maxChannel> channels;
 
         static_assert(moduleNr < 4, "Module number < 4 required");
     };
@@ -25,67 +42,173 @@ namespace TeensyTimerTool
     // IMPLEMENTATION ==================================================================
 
     template <unsigned moduleNr>
-    ITimerChannel* FTM_t<moduleNr>::getTimer()
+    void FTM_t<moduleNr>::init()
     {
-        if (!isInitialized)
+        r->SC = FTM_SC_CLKS(0b00); // Disable clock
+        r->MOD = 0xFFFF;           // Set full counter range
+        r->CNT = 0;
+
+        for (unsigned chNr = 0; chNr < maxChannel; chNr++) // init channels
         {
-            r->SC = FTM_SC_CLKS(0b00); // Disable clock
-            r->MOD = 0xFFFF;           // Set full counter range
-            r->CNT = 0;
+            channelInfo[chNr].isReserved = false;
+            channelInfo[chNr].isActive = false;
+            channelInfo[chNr].ticksLeft = 0;
+            channelInfo[chNr].callback = nullptr;
+            channelInfo[chNr].chRegs = &r->CH[chNr];
+            channelInfo[chNr].scale = TickScale(F_BUS >> FTM_Info<moduleNr>::prescale);
 
-            for (unsigned chNr = 0; chNr < maxChannel; chNr++) // init channels
-            {
-                channelInfo[chNr].isReserved = false;
-                channelInfo[chNr].callback = nullptr;
-                channelInfo[chNr].chRegs = &r->CH[chNr];
-                channelInfo[chNr].ticksPerMicrosecond =  1E-6f * F_BUS / (1 << FTM_Info<moduleNr>::prescale);
-
-                r->CH[chNr].SC &= ~FTM_CSC_CHF;  // FTM requires to clear flag by setting bit to 0
-                r->CH[chNr].SC &= ~FTM_CSC_CHIE; // Disable channel interupt
-                r->CH[chNr].SC = FTM_CSC_MSA;
-            }
-            r->SC = FTM_SC_CLKS(0b01) | FTM_SC_PS(FTM_Info<moduleNr>::prescale); // Start clock
-            attachInterruptVector(FTM_Info<moduleNr>::irqNumber, isr);           // prepare isr and nvic, don't yet enable interrupts
-            NVIC_ENABLE_IRQ(FTM_Info<moduleNr>::irqNumber);
-            isInitialized = true;
+            r->CH[chNr].SC &= ~FTM_CSC_CHF;  // FTM requires to clear flag by setting bit to 0
+            r->CH[chNr].SC &= ~FTM_CSC_CHIE; // Disable channel interupt
+            r->CH[chNr].SC = FTM_CSC_MSA;
         }
+        r->SC = FTM_SC_CLKS(0b01) | FTM_SC_PS(FTM_Info<moduleNr>::prescale); // Start clock
+        attachInterruptVector(FTM_Info<moduleNr>::irqNumber, isr);           // prepare isr and nvic, don't yet enable interrupts
+        NVIC_ENABLE_IRQ(FTM_Info<moduleNr>::irqNumber);
+        isInitialized = true;
+    }
+
+    template <unsigned moduleNr>
+    ITimerChannel* FTM_t<moduleNr>::getTimer()
+    {
+        if (!isInitialized) init();
 
         for (unsigned chNr = 0; chNr < maxChannel; chNr++)
         {
             if (!channelInfo[chNr].isReserved)
             {
                 channelInfo[chNr].isReserved = true;
-                return new FTM_Channel(r, &channelInfo[chNr]);
+                allocated |= 1 << chNr;
+                ITimerChannel* channel = channels.construct(chNr, r, &channelInfo[chNr]);
+#if defined(ENABLE_TIMER_STATS)
+                channelInfo[chNr].stats = &channel->stats;
+#endif
+                return channel;
             }
         }
         return nullptr;
     }
 
+    // The channel keeps a null callback and is handled by the static isr before the generic isr sees it.
+    // Only one static channel per module since it replaces the interrupt vector of the module.
+    template <unsigned moduleNr>
+    template <unsigned chNr, void (*handler)()>
+    ITimerChannel* FTM_t<moduleNr>::getStaticTimer()
+    {
+        static_assert(chNr < maxChannel, "Channel number not available on this module");
+
+        if (!isInitialized) init();
+        if (hasStaticIsr || channelInfo[chNr].isReserved) return nullptr;
+
+        hasStaticIsr = true;
+        channelInfo[chNr].isReserved = true;
+        attachInterruptVector(FTM_Info<moduleNr>::irqNumber, staticIsr<chNr, handler>);
+        ITimerChannel* channel = channels.construct(chNr, r, &channelInfo[chNr]);
+#if defined(ENABLE_TIMER_STATS)
+        channelInfo[chNr].stats = &channel->stats;
+#endif
+        return channel;
+    }
+
     template <unsigned m>
     void FTM_t<m>::isr()
     {
-        for (unsigned i = 0; i < maxChannel; i++)
+        uint32_t pending = r->STATUS & allocated; // flags of all channels with a single bus read
+        if (pending == 0) return;
+        r->STATUS = ~pending; // flags are cleared by writing 0 after reading them, writing 1 has no effect
+
+        do
         {
-            FTM_ChannelInfo* ci = &channelInfo[i]; // pre resolving the references turns out to be slightly faster
-            FTM_CH_t* cr = ci->chRegs;
-            if ((cr->SC & (FTM_CSC_CHIE | FTM_CSC_CHF)) == (FTM_CSC_CHIE | FTM_CSC_CHF)) // only handle if channel is active (CHIE set) and overflowed (CHF set)
+            unsigned chNr = __builtin_ctz(pending);
+            pending &= pending - 1;
+
+            FTM_ChannelInfo* ci = &channelInfo[chNr];
+            if (!ci->isActive) continue; // compare flags are set on every counter wrap, even with disabled interrupt
+
+            if (nextCompare(ci))
             {
-                if (ci->isPeriodic)
-                {
-                    cr->SC &= ~FTM_CSC_CHF;       // clear channel flag
-                    cr->CV = r->CNT + ci->reload; // set compare value to 'reload' counts ahead of counter
-                } else
-                {
-                    cr->SC &= ~FTM_CSC_CHIE;       //disable interrupt in on shot mode
-                }
                 ci->callback();
+#if defined(ENABLE_TIMER_STATS)
+                recordOverrun(ci);
+#endif
             }
+        } while (pending != 0);
+    }
+
+    // sets up the next compare of a channel after a match, returns true if the callback is due
+    template <unsigned m>
+    bool FTM_t<m>::nextCompare(FTM_ChannelInfo* ci)
+    {
+        if (ci->ticksLeft != 0) // extended period, not yet due
+        {
+            ci->chRegs->CV = (uint16_t)(ci->chRegs->CV + ci->nextStep());
+            return false;
         }
+
+#if defined(ENABLE_TIMER_STATS)
+        uint16_t ticks = r->CNT - ci->chRegs->CV; // counter runs from 0 to 0xFFFF, i.e. ticks since the match
+        ci->stats->record((uint64_t)ticks * F_CPU / clockHz);
+#endif
+        if (ci->isPeriodic)
+        {
+            if (ci->reload > 0xFFFF) // extended period, steps are added to the last compare value, i.e., no drift
+            {
+                ci->ticksLeft = ci->reload;
+                ci->chRegs->CV = (uint16_t)(ci->chRegs->CV + ci->nextStep());
+            } else
+                ci->chRegs->CV = r->CNT + ci->reload; // set compare value to 'reload' counts ahead of counter
+        } else
+        {
+            ci->isActive = false;
+            ci->chRegs->SC = FTM_CSC_MSA; // disable interrupt in one shot mode
+        }
+        return true;
+    }
+
+    template <unsigned m>
+    template <unsigned chNr, void (*handler)()>
+    void FTM_t<m>::staticIsr()
+    {
+        FTM_CH_t* cr = &r->CH[chNr];
+        if ((cr->SC & (FTM_CSC_CHIE | FTM_CSC_CHF)) == (FTM_CSC_CHIE | FTM_CSC_CHF)) // static timers are always periodic
+        {
+            cr->SC &= ~FTM_CSC_CHF;
+            if (nextCompare(&channelInfo[chNr]))
+            {
+                handler(); // known at compile time, can be inlined
+#if defined(ENABLE_TIMER_STATS)
+                recordOverrun(&channelInfo[chNr]);
+#endif
+            }
+        }
+
+        if (allocated != 0) isr(); // other channels of the module in use
     }
 
+#if defined(ENABLE_TIMER_STATS)
+    // The compare flag is also set at each counter wrap and at the intermediate compares of extended
+    // periods, only periodic channels with periods <= 0xFFFF ticks can be checked
+    template <unsigned m>
+    void FTM_t<m>::recordOverrun(FTM_ChannelInfo* ci)
+    {
+        if (ci->isActive && ci->ticksLeft == 0 && ci->reload <= 0xFFFF && (ci->chRegs->SC & FTM_CSC_CHF)) ci->stats->overruns++;
+    }
+#endif
+
+    template <unsigned m>
+    FTM_r_t* const FTM_t<m>::r = (FTM_r_t*)FTM_Info<m>::baseAdr; // reinterpret_cast, can't be constexpr
+
     template <unsigned m>
     FTM_ChannelInfo FTM_t<m>::channelInfo[maxChannel];
 
+    template <unsigned m>
+    ChannelStorage<FTM_Channel, FTM_t<m>::maxChannel> FTM_t<m>::channels;
+
     template <unsigned m>
     bool FTM_t<m>::isInitialized = false;
+
+    template <unsigned m>
+    bool FTM_t<m>::hasStaticIsr = false;
+
+    template <unsigned m>
+    uint32_t FTM_t<m>::allocated = 0;
 }
@@ -14,16 +14,23 @@ namespace TeensyTimerTool
         inline virtual ~FTM_Channel();
 
         inline float getMaxPeriod() override;
-        inline errorCode begin(callback_t cb, uint32_t tcnt, bool periodic);
+        inline errorCode begin(ChannelCallback cb, uint32_t tcnt, bool periodic);
         inline errorCode trigger(uint32_t tcnt) FASTRUN;
 
-        inline uint16_t ticksFromMicros(float micros);
-        inline void setPeriod(uint32_t) {}
+        inline errorCode beginTicks(ChannelCallback cb, uint64_t ticks, bool periodic) override;
+        inline errorCode triggerTicks(uint64_t ticks) FASTRUN;
+        inline uint64_t ticksFromMicros(uint32_t micros) override { return ci->scale.ticks(micros); }
+        inline uint64_t ticksFromMicros(float micros) override { return ci->scale.ticks(micros); }
+        inline uint64_t ticksFromNanos(uint64_t nanos) override { return ci->scale.ticksFromNanos(nanos); }
+        inline errorCode setPeriodTicks(uint64_t ticks) override;
+        inline uint32_t getPeriod() override;
 
      protected:
+        inline uint32_t clipReload(uint64_t ticks);
+
         FTM_ChannelInfo* ci;
         FTM_r_t* regs;
-        callback_t* pCallback = nullptr;
+        ChannelCallback* pCallback = nullptr;
     };
 
     // IMPLEMENTATION ==============================================
@@ -35,45 +42,79 @@ namespace TeensyTimerTool
         this->ci = channelInfo;
     }
 
-    errorCode FTM_Channel::begin(callback_t callback, uint32_t tcnt, bool periodic)
+    errorCode FTM_Channel::begin(ChannelCallback callback, uint32_t tcnt, bool periodic)
+    {
+        return beginTicks(callback, ci->scale.ticks(tcnt), periodic);
+    }
+
+    errorCode FTM_Channel::beginTicks(ChannelCallback callback, uint64_t ticks, bool periodic)
     {
+        ci->isActive = false;
         ci->isPeriodic = periodic;
-        ci->reload = ticksFromMicros(tcnt);
+        ci->reload = clipReload(ticks);
+        ci->ticksLeft = ci->reload;
         ci->callback = callback;
 
-        ci->chRegs->CV = regs->CNT + ci->reload;               // compare value (current counter + pReload)
+        ci->chRegs->CV = (uint16_t)(regs->CNT + ci->nextStep()); // compare value (current counter + first step)
         ci->chRegs->SC &= ~FTM_CSC_CHF;                        // reset timer flag
+        ci->isActive = true;
         ci->chRegs->SC = FTM_CSC_MSA | FTM_CSC_CHIE;           // enable interrupts
         return errorCode::OK;
     }
 
     errorCode FTM_Channel::trigger(const uint32_t micros)
     {
-        uint32_t cv = regs->CNT + ticksFromMicros(micros) + 1; // calc early to minimize error
-        ci->chRegs->SC &= ~FTM_CSC_CHF;                        // Reset timer flag
+        return triggerTicks(ci->scale.ticks(micros));
+    }
+
+    // The counter is shared by all channels of the module and keeps running. Only this channel is masked
+    // while the new compare value is taken over, which happens at the next (prescaled) counter tick.
+    // The busy wait below is bounded: FTM_t::init starts the module clock and nothing stops it afterwards,
+    // so CNT changes after at most one prescaled tick (e.g. PSC_128 at F_BUS = 36MHz: 3.6µs). clipReload
+    // clamps the ticks to >= 1, the new compare value is at least two ticks ahead of cnt and can't match
+    // during the wait.
+    errorCode FTM_Channel::triggerTicks(uint64_t ticks)
+    {
+        ci->isActive = false;
+        ci->chRegs->SC = FTM_CSC_MSA;                          // disable interrupt of this channel only
+        ci->ticksLeft = clipReload(ticks);                     // >= 1 tick
 
-        regs->SC &= ~FTM_SC_CLKS_MASK;                         // need to switch off clock to immediately set new CV
-        ci->chRegs->CV = cv;                                   // compare value (current counter + pReload)
-        regs->SC |= FTM_SC_CLKS(0b01);                         // restart clock
+        uint16_t cnt = regs->CNT;
+        ci->chRegs->CV = (uint16_t)(cnt + ci->nextStep() + 1); // compare value (counter at takeover + first step)
+        while (regs->CNT == cnt) {}                            // wait for the takeover, at most one timer tick
 
+        ci->chRegs->SC &= ~FTM_CSC_CHF;                        // discard matches of the old compare value
+        ci->isActive = true;
         ci->chRegs->SC = FTM_CSC_MSA | FTM_CSC_CHIE;           // enable interrupts
         return errorCode::OK;
     }
 
+    errorCode FTM_Channel::setPeriodTicks(uint64_t ticks)
+    {
+        ci->reload = clipReload(ticks); // the isr adds the new reload after the next compare
+        return ticks > 0xFFFF'FFFF ? errorCode::periodOverflow : errorCode::OK;
+    }
+
+    uint32_t FTM_Channel::getPeriod()
+    {
+        return ci->reload / ci->scale.ticksPerMicrosecond();
+    }
+
     float FTM_Channel::getMaxPeriod()
     {
-        return  (0xFFFF * 1E-6f) / ci->ticksPerMicrosecond;    // max period in seconds
+        return  (0xFFFF'FFFF * 1E-6f) / ci->scale.ticksPerMicrosecond(); // max period in seconds
     }
 
-    uint16_t FTM_Channel::ticksFromMicros(float micros)
+    // all tick paths (begin, trigger, setPeriod) go through here
+    uint32_t FTM_Channel::clipReload(uint64_t ticks)
     {
-        uint32_t rl = ci->ticksPerMicrosecond * micros;
-        if (rl > 0xFFFF)
+        ticks = atLeastOneTick(ticks);
+        if (ticks > 0xFFFF'FFFF)
         {
             postError(errorCode::periodOverflow);              // warning only, continues with clipped value
-            rl = 0xFFFF;
+            return 0xFFFF'FFFF;
         }
-        return rl;
+        return ticks;
     }
 
     FTM_Channel::~FTM_Channel()
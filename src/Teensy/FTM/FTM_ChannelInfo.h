@@ -1,17 +1,36 @@
 #pragma once
 
+#include "../TickScale.h"
 #include "FTM_Info.h"
 #include "../../types.h"
 
+#if defined(ENABLE_TIMER_STATS)
+    #include "../../timerStats.h"
+#endif
+
 namespace TeensyTimerTool
 {
     struct FTM_ChannelInfo
     {
         bool isReserved;
         bool isPeriodic;
-        callback_t callback;
-        uint32_t reload;
+        bool isActive; // interrupt enabled, mirrors CHIE to spare the register read in the isr
+        ChannelCallback callback;
+        uint32_t reload;    // ticks, periods > 0xFFFF are split into several compares (extended mode)
+        uint32_t ticksLeft; // ticks after the next compare until the callback is due
         FTM_CH_t* chRegs;
-        float ticksPerMicrosecond;
+        TickScale scale;
+#if defined(ENABLE_TIMER_STATS)
+        TimerStats* stats; // of the channel object
+#endif
+
+        // Ticks to the next compare. Steps are full counter wraps (CV unchanged) and two final
+        // steps >= 0x8000, so that the isr never has to set a compare value close to the counter.
+        inline uint32_t nextStep()
+        {
+            uint32_t step = ticksLeft > 0x1'FFFF ? 0x1'0000 : ticksLeft > 0xFFFF ? ticksLeft / 2 : ticksLeft;
+            ticksLeft -= step;
+            return step;
+        }
     };
 }
\ No newline at end of file
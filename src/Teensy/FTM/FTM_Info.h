@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../hardware.h"
 #include "boardDef.h"
 #include <algorithm>
 
@@ -10,36 +11,36 @@ namespace TeensyTimerTool
 {
     typedef struct // FTM & TPM Channels
     {
-        volatile uint32_t SC;
-        volatile uint32_t CV;
+        reg32_t SC;
+        reg32_t CV;
     } FTM_CH_t;
 
     typedef struct // FTM register block (this layout is compatible to a TPM register block)
     {
-        volatile uint32_t SC;
-        volatile uint32_t CNT;
-        volatile uint32_t MOD;
+        reg32_t SC;
+        reg32_t CNT;
+        reg32_t MOD;
         FTM_CH_t CH[8];
-        volatile uint32_t CNTIN;
-        volatile uint32_t STATUS;
-        volatile uint32_t MODE;
-        volatile uint32_t SYNC;
-        volatile uint32_t OUTINIT;
-        volatile uint32_t OUTMASK;
-        volatile uint32_t COMBINE;
-        volatile uint32_t DEADTIME;
-        volatile uint32_t EXTTRIG;
-        volatile uint32_t POL;
-        volatile uint32_t FMS;
-        volatile uint32_t FILTER;
-        volatile uint32_t FLTCTRL;
-        volatile uint32_t QDCTRL;
-        volatile uint32_t CONF;
-        volatile uint32_t FLTPOL;
-        volatile uint32_t SYNCONF;
-        volatile uint32_t INVCTRL;
-        volatile uint32_t SWOCTRL;
-        volatile uint32_t PWMLOAD;
+        reg32_t CNTIN;
+        reg32_t STATUS;
+        reg32_t MODE;
+        reg32_t SYNC;
+        reg32_t OUTINIT;
+        reg32_t OUTMASK;
+        reg32_t COMBINE;
+        reg32_t DEADTIME;
+        reg32_t EXTTRIG;
+        reg32_t POL;
+        reg32_t FMS;
+        reg32_t FILTER;
+        reg32_t FLTCTRL;
+        reg32_t QDCTRL;
+        reg32_t CONF;
+        reg32_t FLTPOL;
+        reg32_t SYNCONF;
+        reg32_t INVCTRL;
+        reg32_t SWOCTRL;
+        reg32_t PWMLOAD;
     } FTM_r_t;
 
     //=======================================================================
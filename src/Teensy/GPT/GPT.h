@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../ChannelStorage.h"
 #include "GPTChannel.h"
 
 namespace TeensyTimerTool
@@ -10,11 +11,24 @@ namespace TeensyTimerTool
      public:
         static ITimerChannel* getTimer();
 
+        template <unsigned chNr, void (*handler)()>
+        static ITimerChannel* getStaticTimer(); // serviced by a dedicated isr which calls handler directly
+
+        static constexpr uint64_t clockHz = USE_GPT_PIT_150MHz ? 150'000'000 : 24'000'000; // for compile time conversion of ConstDurations (nominal F_BUS)
+        static constexpr uint64_t maxTicks = 0xFFFF'FFFF;
+
      protected:
         static bool isInitialized;
+        static ITimerChannel* init(void (*moduleIsr)());
         static void isr();
-        static callback_t callback;
+        template <void (*handler)()>
+        static void staticIsr();
+        static ChannelCallback callback;
         static GptChannel* channel;
+        static ChannelStorage<GptChannel, 1> storage;
+#if defined(ENABLE_TIMER_STATS)
+        static inline void recordLateness();
+#endif
 
         // the following is calculated at compile time
         static constexpr IRQ_NUMBER_t irq = moduleNr == 0 ? IRQ_GPT1 : IRQ_GPT2;
@@ -30,48 +44,98 @@ namespace TeensyTimerTool
     template <unsigned moduleNr>
     ITimerChannel* GPT_t<moduleNr>::getTimer()
     {
-        if (!isInitialized)
-        {
-            isInitialized = true;
+        return isInitialized ? nullptr : init(isr);
+    }
+
+    template <unsigned moduleNr>
+    template <unsigned chNr, void (*handler)()>
+    ITimerChannel* GPT_t<moduleNr>::getStaticTimer()
+    {
+        static_assert(chNr == 0, "GPT modules only have one channel");
+        return isInitialized ? nullptr : init(staticIsr<handler>);
+    }
+
+    template <unsigned moduleNr>
+    ITimerChannel* GPT_t<moduleNr>::init(void (*moduleIsr)())
+    {
+        isInitialized = true;
 
-            if (moduleNr == 0) // GPT1 clock settings
-                CCM_CCGR1 |= CCM_CCGR1_GPT1_BUS(CCM_CCGR_ON) | CCM_CCGR1_GPT1_SERIAL(CCM_CCGR_ON);
-            else // GPT2
-                CCM_CCGR0 |= CCM_CCGR0_GPT2_BUS(CCM_CCGR_ON) | CCM_CCGR0_GPT2_SERIAL(CCM_CCGR_ON);
+        if (moduleNr == 0) // GPT1 clock settings
+            CCM_CCGR1 |= CCM_CCGR1_GPT1_BUS(CCM_CCGR_ON) | CCM_CCGR1_GPT1_SERIAL(CCM_CCGR_ON);
+        else // GPT2
+            CCM_CCGR0 |= CCM_CCGR0_GPT2_BUS(CCM_CCGR_ON) | CCM_CCGR0_GPT2_SERIAL(CCM_CCGR_ON);
 
-            if(USE_GPT_PIT_150MHz) // timer clock setting from config.h
-                CCM_CSCMR1 &= ~CCM_CSCMR1_PERCLK_CLK_SEL; // 150MHz
-            else
-                CCM_CSCMR1 |= CCM_CSCMR1_PERCLK_CLK_SEL;  // 24MHz
+        if(USE_GPT_PIT_150MHz) // timer clock setting from config.h
+            CCM_CSCMR1 &= ~CCM_CSCMR1_PERCLK_CLK_SEL; // 150MHz
+        else
+            CCM_CSCMR1 |= CCM_CSCMR1_PERCLK_CLK_SEL;  // 24MHz
 
-            pGPT->CR = GPT_CR_CLKSRC(0x001) | GPT_CR_ENMOD; // stopped, restart mode and peripheral clock
+        pGPT->CR = GPT_CR_CLKSRC(0x001) | GPT_CR_ENMOD; // stopped, restart mode and peripheral clock
 
-            attachInterruptVector(irq, isr);
-            NVIC_ENABLE_IRQ(irq);
+        attachInterruptVector(irq, moduleIsr);
+        NVIC_ENABLE_IRQ(irq);
 
-            channel = new GptChannel(pGPT, &callback);
-            return channel;
-        }
-        return nullptr;
+        channel = storage.construct(0, pGPT, &callback);
+        return channel;
     }
 
     template <unsigned tmoduleNr>
     void GPT_t<tmoduleNr>::isr()
     {
+#if defined(ENABLE_TIMER_STATS)
+        recordLateness();
+#endif
         if (!channel->isPeriodic)
             pGPT->CR &= ~GPT_CR_EN; // stop timer in one shot mode
 
         pGPT->SR = 0x3F; // reset all interrupt flags
+        channel->updateReload();
         callback();      // we only enabled the OF1 interrupt-> no need to find out which interrupt was actually called
-        pGPT->SR;                 // re-read flag to prevent re entering, takes very long, seems to work without?
+#if defined(ENABLE_TIMER_STATS)
+        if (pGPT->SR & GPT_SR_OF1) channel->stats.overruns++; // next compare during the callback, the read also prevents re entering
+#else
+        (void)(uint32_t)pGPT->SR; // re-read flag to prevent re entering, takes very long, seems to work without?
+#endif
     }
 
+    template <unsigned m>
+    template <void (*handler)()>
+    void GPT_t<m>::staticIsr()
+    {
+#if defined(ENABLE_TIMER_STATS)
+        recordLateness();
+#endif
+        pGPT->SR = 0x3F;   // static timers are always periodic
+        channel->updateReload();
+        handler(); // known at compile time, can be inlined
+#if defined(ENABLE_TIMER_STATS)
+        if (pGPT->SR & GPT_SR_OF1) channel->stats.overruns++;
+#else
+        (void)(uint32_t)pGPT->SR;
+#endif
+    }
+
+#if defined(ENABLE_TIMER_STATS)
+    // Restart mode: the counter shows the compare value until the next tick and restarts from 0 then.
+    // Needs to be called before a one shot timer is stopped.
+    template <unsigned m>
+    void GPT_t<m>::recordLateness()
+    {
+        uint32_t cnt = pGPT->CNT;
+        uint32_t ticks = cnt == pGPT->OCR1 ? 0 : cnt + 1;
+        channel->stats.record((uint64_t)ticks * F_CPU / clockHz);
+    }
+#endif
+
     template <unsigned m>
     bool GPT_t<m>::isInitialized = false;
 
     template <unsigned m>
-    callback_t GPT_t<m>::callback = nullptr;
+    ChannelCallback GPT_t<m>::callback = nullptr;
 
     template <unsigned m>
     GptChannel* GPT_t<m>::channel = nullptr;
+
+    template <unsigned m>
+    ChannelStorage<GptChannel, 1> GPT_t<m>::storage;
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../ITimerChannel.h"
+#include "../TickScale.h"
 #include "GPTmap.h"
 #include "core_pins.h"
 
@@ -9,51 +10,67 @@ namespace TeensyTimerTool
     class GptChannel : public ITimerChannel
     {
      public:
-        inline GptChannel(IMXRT_GPT_t*, callback_t*);
+        inline GptChannel(IMXRT_GPT_t*, ChannelCallback*);
         inline virtual ~GptChannel();
 
-        inline errorCode begin(callback_t cb, float tcnt, bool periodic) override;
-        inline errorCode begin(callback_t cb, uint32_t tcnt, bool periodic) override;
+        inline errorCode begin(ChannelCallback cb, float tcnt, bool periodic) override;
+        inline errorCode begin(ChannelCallback cb, uint32_t tcnt, bool periodic) override;
 
         inline errorCode trigger(uint32_t) override;
         inline errorCode trigger(float) override;
-        inline void setPeriod(uint32_t) {}
+
+        inline errorCode beginTicks(ChannelCallback cb, uint64_t ticks, bool periodic) override;
+        inline errorCode triggerTicks(uint64_t ticks) override;
+        inline uint64_t ticksFromMicros(uint32_t micros) override { return scale.ticks(micros); }
+        inline uint64_t ticksFromMicros(float micros) override { return scale.ticks(micros); }
+        inline uint64_t ticksFromNanos(uint64_t nanos) override { return scale.ticksFromNanos(nanos); }
+        inline errorCode setPeriodTicks(uint64_t ticks) override;
+        inline uint32_t getPeriod() override { return (reload + 1.0f) / scale.ticksPerMicrosecond(); }
         inline float getMaxPeriod() override;
 
-        bool isPeriodic;
+        inline void updateReload(); // called by the isr right after the compare
+
+        bool isPeriodic = false;
 
      protected:
         IMXRT_GPT_t* regs;
-        uint32_t reload;
+        uint32_t reload = 0;
+        volatile bool reloadPending = false;
+        TickScale scale; // clock is selected before the channel is constructed (GPT_t::init)
     };
 
     // IMPLEMENTATION ==============================================
 
-    GptChannel::GptChannel(IMXRT_GPT_t* registers, callback_t* cbStorage)
+    GptChannel::GptChannel(IMXRT_GPT_t* registers, ChannelCallback* cbStorage)
         : ITimerChannel(cbStorage), regs(registers)
     {
+        scale = TickScale((CCM_CSCMR1 & CCM_CSCMR1_PERCLK_CLK_SEL) ? 24'000'000 : F_BUS_ACTUAL);
+    }
+
+    errorCode GptChannel::begin(ChannelCallback cb, uint32_t micros, bool periodic)
+    {
+        return beginTicks(cb, scale.ticks(micros), periodic);
     }
 
-    errorCode GptChannel::begin(callback_t cb, uint32_t micros, bool periodic)
+    errorCode GptChannel::begin(ChannelCallback cb, float micros, bool periodic)
     {
-        return begin(cb, (float)micros, periodic);
+        return beginTicks(cb, scale.ticks(micros), periodic);
     }
 
-    errorCode GptChannel::begin(callback_t cb, float micros, bool periodic)
+    errorCode GptChannel::beginTicks(ChannelCallback cb, uint64_t ticks, bool periodic)
     {
         isPeriodic = periodic;
+        reloadPending = false;
         setCallback(cb);
+        ticks = atLeastOneTick(ticks);
         if (isPeriodic)
         {
-            uint32_t pid_clock_mhz = (CCM_CSCMR1 & CCM_CSCMR1_PERCLK_CLK_SEL) ? 24 : (F_BUS_ACTUAL / 1000000);
-            float tmp = micros * pid_clock_mhz;
-
-            if (tmp > 0xFFFF'FFFF)
+            if (ticks > 0xFFFF'FFFF)
             {
                 postError(errorCode::periodOverflow);
                 reload = 0xFFFF'FFFE;
             } else
-                reload = (uint32_t)tmp - 1;
+                reload = (uint32_t)ticks - 1;
 
             regs->SR = 0x3F;         // clear all interupt flags
             regs->IR = GPT_IR_OF1IE; // enable OF1 interrupt
@@ -72,20 +89,23 @@ namespace TeensyTimerTool
 
     errorCode GptChannel::trigger(uint32_t delay)
     {
-        return trigger((float)delay);
+        return triggerTicks(scale.ticks(delay));
     }
 
-    errorCode GptChannel::trigger(float delay) //should be optimized somehow
+    errorCode GptChannel::trigger(float delay)
     {
-        uint32_t pid_clock_mhz = (CCM_CSCMR1 & CCM_CSCMR1_PERCLK_CLK_SEL) ? 24 : (F_BUS_ACTUAL / 1000000);
-        float tmp = delay * pid_clock_mhz;
+        return triggerTicks(scale.ticks(delay));
+    }
 
-        if (tmp > 0xFFFF'FFFF)
+    errorCode GptChannel::triggerTicks(uint64_t ticks)
+    {
+        ticks = atLeastOneTick(ticks);
+        if (ticks > 0xFFFF'FFFF)
         {
             postError(errorCode::periodOverflow);
             reload = 0xFFFF'FFFE;
         } else
-            reload = (uint32_t)tmp - 1;
+            reload = (uint32_t)ticks - 1;
 
         regs->SR = 0x3F;         // clear all interupt flags
         regs->IR = GPT_IR_OF1IE; // enable OF1 interrupt
@@ -95,10 +115,40 @@ namespace TeensyTimerTool
         return errorCode::OK;
     }
 
+    // The GPT has no preload register and writing OCR1 restarts the counter in restart mode.
+    // A running periodic timer therefore gets the new reload from the isr, i.e., the phase is
+    // only shifted by the interrupt latency.
+    errorCode GptChannel::setPeriodTicks(uint64_t ticks)
+    {
+        errorCode err = errorCode::OK;
+        ticks = atLeastOneTick(ticks);
+        if (ticks > 0xFFFF'FFFF)
+        {
+            err = postError(errorCode::periodOverflow);
+            ticks = 0xFFFF'FFFF;
+        }
+        reload = (uint32_t)ticks - 1;
+
+        if (isPeriodic && (regs->CR & GPT_CR_EN))
+            reloadPending = true;
+        else
+            regs->OCR1 = reload;
+
+        return err;
+    }
+
+    void GptChannel::updateReload()
+    {
+        if (reloadPending)
+        {
+            regs->OCR1 = reload;
+            reloadPending = false;
+        }
+    }
+
     float GptChannel::getMaxPeriod()
     {
-        uint32_t pid_clock_mhz = (CCM_CSCMR1 & CCM_CSCMR1_PERCLK_CLK_SEL) ? 24 : (F_BUS_ACTUAL / 1000000);
-        return  (float) 0xFFFF'FFFE / pid_clock_mhz;
+        return (float)0xFFFF'FFFE / scale.ticksPerMicrosecond();
     }
 
 } // namespace TeensyTimerTool
\ No newline at end of file
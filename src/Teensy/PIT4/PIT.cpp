@@ -5,9 +5,11 @@
 namespace TeensyTimerTool
 {
     bool PIT_t::isInitialized = false;
+    int PIT_t::staticChNr = -1;
+    uint32_t PIT_t::allocated = 0;
     PITChannel PIT_t::channel[4] = {{0}, {1}, {2}, {3}};
 
-     uint32_t PITChannel::clockFactor = 1;
+    TickScale PITChannel::scale;
 }
 
 #endif
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../hardware.h"
 #include "PITChannel.h"
 
 namespace TeensyTimerTool
@@ -9,62 +10,130 @@ namespace TeensyTimerTool
      public:
         inline static ITimerChannel* getTimer();
 
+        template <unsigned chNr, void (*handler)()>
+        static ITimerChannel* getStaticTimer(); // channel chNr, serviced by a dedicated isr which calls handler directly
+
+        static constexpr uint64_t clockHz = USE_GPT_PIT_150MHz ? 150'000'000 : 24'000'000; // for compile time conversion of ConstDurations (nominal F_BUS)
+        static constexpr uint64_t maxTicks = 0xFFFF'FFFF;
+
      protected:
         static bool isInitialized;
+        static int staticChNr; // channel reserved by getStaticTimer, -1 if none
+        static uint32_t allocated; // channels handed out by getTimer (one bit per channel), serviced by isr()
+        inline static void init();
         static void isr();
+        template <unsigned chNr, void (*handler)()>
+        static void staticIsr();
         static PITChannel channel[4];
+
+#if defined(ENABLE_TIMER_STATS)
+        static inline void recordLateness(unsigned chNr);
+        static inline void recordOverrun(unsigned chNr);
+#endif
     };
 
     // IMPLEMENTATION ===========================================================================
 
-    ITimerChannel* PIT_t::getTimer()
+    void PIT_t::init()
     {
-        if (!isInitialized)
-        {
-            isInitialized = true;
+        isInitialized = true;
 
-            CCM_CCGR1 |= CCM_CCGR1_PIT(CCM_CCGR_ON);
-            PIT_MCR = 1;
+        CCM_CCGR1 |= CCM_CCGR1_PIT(CCM_CCGR_ON);
+        PIT_MCR = 1;
 
-            if (USE_GPT_PIT_150MHz)                       // timer clock setting from config.h
-                CCM_CSCMR1 &= ~CCM_CSCMR1_PERCLK_CLK_SEL; // FBus (usually 150MHz)
-            else
-                CCM_CSCMR1 |= CCM_CSCMR1_PERCLK_CLK_SEL; // 24MHz
+        if (USE_GPT_PIT_150MHz)                       // timer clock setting from config.h
+            CCM_CSCMR1 &= ~CCM_CSCMR1_PERCLK_CLK_SEL; // FBus (usually 150MHz)
+        else
+            CCM_CSCMR1 |= CCM_CSCMR1_PERCLK_CLK_SEL; // 24MHz
+        PITChannel::scale = TickScale(USE_GPT_PIT_150MHz ? F_BUS_ACTUAL : 24'000'000);
 
-            attachInterruptVector(IRQ_PIT, isr);
-            NVIC_ENABLE_IRQ(IRQ_PIT);
-        }
+        attachInterruptVector(IRQ_PIT, isr);
+        NVIC_ENABLE_IRQ(IRQ_PIT);
+    }
+
+    ITimerChannel* PIT_t::getTimer()
+    {
+        if (!isInitialized) init();
 
         for (unsigned i = 0; i < 4; i++)
         {
-            if (channel[i].callback == nullptr) return &channel[i];
+            if (!(allocated & (1 << i)) && (int)i != staticChNr) // channels keep a null callback until begin()
+            {
+                allocated |= 1 << i;
+                return &channel[i];
+            }
         }
         return nullptr;
     }
 
+    // The static isr owns the channel and clears its flag. The channel is not added to 'allocated', the generic isr never visits it.
+    // Only one static channel since it replaces the interrupt vector of the PIT module.
+    template <unsigned chNr, void (*handler)()>
+    ITimerChannel* PIT_t::getStaticTimer()
+    {
+        static_assert(chNr < 4, "Channel number < 4 required");
+
+        if (!isInitialized) init();
+        if (staticChNr >= 0 || (allocated & (1 << chNr))) return nullptr;
+
+        staticChNr = chNr;
+        attachInterruptVector(IRQ_PIT, staticIsr<chNr, handler>);
+        return &channel[chNr];
+    }
+
     inline void PIT_t::isr()
     {
-        if (IMXRT_PIT_CHANNELS[0].TFLG)
+        // the PIT has no common flag register, only the TFLG of allocated channels is read
+        for (uint32_t pending = allocated; pending != 0; pending &= pending - 1)
         {
-            IMXRT_PIT_CHANNELS[0].TFLG = 1;
-            channel[0].isr();
+            unsigned chNr = __builtin_ctz(pending);
+            if (IMXRT_PIT_CHANNELS[chNr].TFLG)
+            {
+                IMXRT_PIT_CHANNELS[chNr].TFLG = 1;
+#if defined(ENABLE_TIMER_STATS)
+                recordLateness(chNr);
+#endif
+                channel[chNr].isr();
+#if defined(ENABLE_TIMER_STATS)
+                recordOverrun(chNr);
+#endif
+            }
         }
-        if (IMXRT_PIT_CHANNELS[1].TFLG)
-        {
-            IMXRT_PIT_CHANNELS[1].TFLG = 1;
-            channel[1].isr();
-        }
-        if (IMXRT_PIT_CHANNELS[2].TFLG)
-        {
-            IMXRT_PIT_CHANNELS[2].TFLG = 1;
-            channel[2].isr();
-        }
-        if (IMXRT_PIT_CHANNELS[3].TFLG)
+
+        dataSyncBarrier();
+    }
+
+    template <unsigned chNr, void (*handler)()>
+    void PIT_t::staticIsr()
+    {
+        if (IMXRT_PIT_CHANNELS[chNr].TFLG)
         {
-            IMXRT_PIT_CHANNELS[3].TFLG = 1;
-            channel[3].isr();
+            IMXRT_PIT_CHANNELS[chNr].TFLG = 1;
+#if defined(ENABLE_TIMER_STATS)
+            recordLateness(chNr);
+#endif
+            handler(); // known at compile time, can be inlined
+#if defined(ENABLE_TIMER_STATS)
+            recordOverrun(chNr);
+#endif
         }
 
-        asm volatile("dsb"); //wait until register changes propagated through the cache
+        if (allocated != 0) // other channels in use
+            isr();
+        else
+            dataSyncBarrier();
+    }
+
+#if defined(ENABLE_TIMER_STATS)
+    void PIT_t::recordLateness(unsigned chNr) // the channel reloaded at the event and counts down from LDVAL since then
+    {
+        uint32_t ticks = IMXRT_PIT_CHANNELS[chNr].LDVAL - IMXRT_PIT_CHANNELS[chNr].CVAL;
+        channel[chNr].stats.record((uint64_t)ticks * F_CPU / clockHz);
+    }
+
+    void PIT_t::recordOverrun(unsigned chNr) // one shot channels are switched off after the callback
+    {
+        if (channel[chNr].isPeriodic && IMXRT_PIT_CHANNELS[chNr].TFLG) channel[chNr].stats.overruns++;
     }
+#endif
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../ITimerChannel.h"
+#include "../TickScale.h"
 #include "PITMap.h"
 #include "core_pins.h"
 
@@ -14,12 +15,19 @@ namespace TeensyTimerTool
         inline PITChannel(unsigned nr);
         inline virtual ~PITChannel();
 
-        inline errorCode begin(callback_t cb, float tcnt, bool periodic) override;
-        inline errorCode begin(callback_t cb, uint32_t tcnt, bool periodic) override;
+        inline errorCode begin(ChannelCallback cb, float tcnt, bool periodic) override;
+        inline errorCode begin(ChannelCallback cb, uint32_t tcnt, bool periodic) override;
 
         inline errorCode trigger(uint32_t) override;
         inline errorCode trigger(float) override;
-        inline void setPeriod(uint32_t) {}
+
+        inline errorCode beginTicks(ChannelCallback cb, uint64_t ticks, bool periodic) override;
+        inline errorCode triggerTicks(uint64_t ticks) override;
+        inline uint64_t ticksFromMicros(uint32_t micros) override { return scale.ticks(micros); }
+        inline uint64_t ticksFromMicros(float micros) override { return scale.ticks(micros); }
+        inline uint64_t ticksFromNanos(uint64_t nanos) override { return scale.ticksFromNanos(nanos); }
+        inline errorCode setPeriodTicks(uint64_t ticks) override;
+        inline uint32_t getPeriod() override;
         inline float getMaxPeriod() override;
 
         bool isPeriodic;
@@ -34,9 +42,9 @@ namespace TeensyTimerTool
         PITChannel(const PITChannel&) = delete;
 
         const unsigned chNr;
-        callback_t callback = nullptr;
+        ChannelCallback callback = nullptr;
 
-        static uint32_t clockFactor;
+        static TickScale scale; // common clock of all channels, set by PIT_t::init
 
         friend PIT_t;
     };
@@ -47,31 +55,35 @@ namespace TeensyTimerTool
         : ITimerChannel(nullptr), chNr(nr)
     {
         callback = nullptr;
-        clockFactor = (CCM_CSCMR1 & CCM_CSCMR1_PERCLK_CLK_SEL) ? 24 : (F_BUS_ACTUAL / 1000000);
     }
 
-    errorCode PITChannel::begin(callback_t cb, uint32_t micros, bool periodic)
+    errorCode PITChannel::begin(ChannelCallback cb, uint32_t micros, bool periodic)
     {
-        return begin(cb, (float)micros, periodic);
+        return beginTicks(cb, scale.ticks(micros), periodic);
     }
 
-    errorCode PITChannel::begin(callback_t cb, float micros, bool periodic)
+    errorCode PITChannel::begin(ChannelCallback cb, float micros, bool periodic)
+    {
+        return beginTicks(cb, scale.ticks(micros), periodic);
+    }
+
+    errorCode PITChannel::beginTicks(ChannelCallback cb, uint64_t ticks, bool periodic)
     {
         isPeriodic = periodic;
         callback = cb;
+        ticks = atLeastOneTick(ticks);
 
         if (isPeriodic)
         {
             IMXRT_PIT_CHANNELS[chNr].TCTRL = 0;
             IMXRT_PIT_CHANNELS[chNr].TFLG = 1;
 
-            float tmp = micros * clockFactor;
-            if (tmp > 0xFFFF'FFFF)
+            if (ticks > 0xFFFF'FFFF)
             {
                 postError(errorCode::periodOverflow);
                 IMXRT_PIT_CHANNELS[chNr].LDVAL = 0xFFFF'FFFE;
             } else
-                IMXRT_PIT_CHANNELS[chNr].LDVAL = (uint32_t)tmp - 1;
+                IMXRT_PIT_CHANNELS[chNr].LDVAL = (uint32_t)ticks - 1;
 
             IMXRT_PIT_CHANNELS[chNr].TCTRL = PIT_TCTRL_TEN | PIT_TCTRL_TIE;
         }
@@ -94,30 +106,52 @@ namespace TeensyTimerTool
 
     errorCode PITChannel::trigger(uint32_t delay)
     {
-        return trigger((float)delay);
+        return triggerTicks(scale.ticks(delay));
     }
 
-    errorCode PITChannel::trigger(float delay) //should be optimized somehow
+    errorCode PITChannel::trigger(float delay)
+    {
+        return triggerTicks(scale.ticks(delay));
+    }
+
+    errorCode PITChannel::triggerTicks(uint64_t ticks)
     {
         IMXRT_PIT_CHANNELS[chNr].TCTRL = 0;
         IMXRT_PIT_CHANNELS[chNr].TFLG = 1;
 
-        float tmp = delay * clockFactor;
-        if (tmp > 0xFFFF'FFFF)
+        ticks = atLeastOneTick(ticks);
+        if (ticks > 0xFFFF'FFFF)
         {
             postError(errorCode::periodOverflow);
             IMXRT_PIT_CHANNELS[chNr].LDVAL = 0xFFFF'FFFE;
         } else
-            IMXRT_PIT_CHANNELS[chNr].LDVAL = (uint32_t)tmp - 1;
+            IMXRT_PIT_CHANNELS[chNr].LDVAL = (uint32_t)ticks - 1;
 
         IMXRT_PIT_CHANNELS[chNr].TCTRL = PIT_TCTRL_TEN | PIT_TCTRL_TIE;
 
         return errorCode::OK;
     }
 
+    errorCode PITChannel::setPeriodTicks(uint64_t ticks)
+    {
+        ticks = atLeastOneTick(ticks);
+        if (ticks > 0xFFFF'FFFF)
+        {
+            IMXRT_PIT_CHANNELS[chNr].LDVAL = 0xFFFF'FFFE;
+            return postError(errorCode::periodOverflow);
+        }
+        IMXRT_PIT_CHANNELS[chNr].LDVAL = (uint32_t)ticks - 1; // a running timer loads the new value when it expires next time
+        return errorCode::OK;
+    }
+
+    uint32_t PITChannel::getPeriod()
+    {
+        return (IMXRT_PIT_CHANNELS[chNr].LDVAL + 1.0f) / scale.ticksPerMicrosecond();
+    }
+
     float PITChannel::getMaxPeriod()
     {
-        return (float)0xFFFF'FFFE / clockFactor;
+        return (float)0xFFFF'FFFE / scale.ticksPerMicrosecond();
     }
 
 
@@ -6,7 +6,34 @@
     namespace TeensyTimerTool
     {
         bool TCK_t::isInitialized = false;
+        uint32_t TCK_t::dueCNT = 0;
+        uint32_t TCK_t::dueTicks = 0;
+        uint32_t TCK_t::missed = 0;
+        uint32_t TckClock::lastCNT = 0;
+        uint32_t TckClock::wraps = 0;
+
+        #if TCK_SCHEDULER == TCK_SCHEDULER_COMPACT
+        TckChannel TCK_t::channels[NR_OF_TCK_TIMERS];
+        uint64_t TCK_t::startCNT[NR_OF_TCK_TIMERS];
+        uint64_t TCK_t::period[NR_OF_TCK_TIMERS];
+        ChannelCallback TCK_t::callbacks[NR_OF_TCK_TIMERS];
+        uint32_t TCK_t::allocated[nrOfWords];
+        uint32_t TCK_t::active[nrOfWords];
+        uint32_t TCK_t::periodic[nrOfWords];
+        #else
         TckChannel* TCK_t::channels[NR_OF_TCK_TIMERS];
+        ChannelStorage<TckChannel, NR_OF_TCK_TIMERS> TCK_t::storage;
+        TckChannel* TCK_t::head = nullptr;
+        #endif
+
+        #if TCK_SCHEDULER == TCK_SCHEDULER_WHEEL
+        TckChannel* TckWheel::slots[nrOfLevels][slotsPerLevel];
+        uint64_t TckWheel::occupied[nrOfLevels];
+        uint32_t TckWheel::wheelTime;
+        uint32_t TckWheel::wheelCNT;
+        unsigned TckWheel::armed;
+        TckChannel* TckWheel::expired;
+        #endif
     }
 
     //----------------------------------------------------------------------
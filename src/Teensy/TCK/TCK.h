@@ -1,22 +1,50 @@
 #pragma once
 
+#include "TckClock.h"
+
+#if TCK_SCHEDULER == TCK_SCHEDULER_COMPACT
+    #include "TckCompact.h"
+#else
+
+#include "../ChannelStorage.h"
 #include "TckChannel.h"
+#include "TckWheel.h"
 #include "core_pins.h"
 
 namespace TeensyTimerTool
 {
     extern const unsigned NR_OF_TCK_TIMERS;
-    
+
     class TCK_t
     {
      public:
         static inline ITimerChannel* getTimer();
         static inline void removeTimer(TckChannel*);
         static inline void tick();
+        static inline uint32_t missedPeriods() { return missed; } // periods dropped before the running callback (TCK_COALESCE)
+        static inline uint32_t ticksUntilDue(); // until tick() has something to do (at most maxDueTicks), e.g. to sleep or to advance a virtual clock
 
      protected:
         static bool isInitialized;
         static TckChannel* channels[NR_OF_TCK_TIMERS];
+        static ChannelStorage<TckChannel, NR_OF_TCK_TIMERS> storage;
+
+        // deadline ordered list of running channels (TCK_SCHEDULER_SORTED)
+        static TckChannel* head;
+        static inline void schedule(TckChannel*);
+        static inline void unschedule(TckChannel*);
+        static inline uint64_t remaining(const TckChannel*, uint64_t now);
+
+        // cached earliest deadline, tick() only dispatches if dueTicks have elapsed since dueCNT
+        static uint32_t dueCNT, dueTicks;
+        static constexpr uint32_t maxDueTicks = 0x8000'0000; // dispatch at least twice per counter wrap to keep TckClock in sync
+        static inline void setDue(uint64_t now, uint64_t ticks);
+        static inline void dispatch();
+        static inline void updateDue();
+
+        static uint32_t missed;
+
+        friend TckChannel;
     };
 
     // IMPLEMENTATION ==================================================================
@@ -33,6 +61,9 @@ namespace TeensyTimerTool
             {
                 channels[chNr] = nullptr;
             }
+#if TCK_SCHEDULER == TCK_SCHEDULER_WHEEL
+            TckWheel::begin();
+#endif
             isInitialized = true;
         }
 
@@ -40,7 +71,7 @@ namespace TeensyTimerTool
         {
             if (channels[chNr] == nullptr)
             {
-                channels[chNr] = new TckChannel();
+                channels[chNr] = storage.construct(chNr);
                 return channels[chNr];
             }
         }
@@ -54,21 +85,339 @@ namespace TeensyTimerTool
         {
             if (channels[chNr] == channel)
             {
+                unschedule(channel);
                 channels[chNr] = nullptr;
-                delete channel;
+                storage.destroy(channel);
                 break;
             }
         }
     }
 
     void TCK_t::tick()
+    {
+        if (TckCounter::read() - dueCNT >= dueTicks) dispatch(); // single compare if nothing is due
+    }
+
+    uint32_t TCK_t::ticksUntilDue()
+    {
+        uint32_t primask = tckDisableInterrupts();
+        uint32_t elapsed = TckCounter::read() - dueCNT;
+        uint32_t ticks = elapsed >= dueTicks ? 0 : dueTicks - elapsed;
+        tckRestoreInterrupts(primask);
+        return ticks;
+    }
+
+#if TCK_SCHEDULER == TCK_SCHEDULER_SORTED
+
+    void TCK_t::dispatch()
+    {
+        static bool lock = false;
+        if (lock) return;
+
+        uint64_t now = TckClock::now();
+        while (head != nullptr && remaining(head, now) == 0)
+        {
+            lock = true;
+            uint32_t primask = tckDisableInterrupts();
+            TckChannel* channel = head;
+            head = channel->next;
+            channel->next = nullptr;
+            channel->triggered = channel->periodic; // i.e., stays triggerd if periodic, stops if oneShot
+#if defined(ENABLE_TIMER_STATS)
+            channel->stats.record(TckCounter::read() - (uint32_t)(channel->startCNT + channel->period)); // before rearming
+#endif
+            missed = 0;
+            if (channel->periodic)
+            {
+                missed = tckRearm(channel->startCNT, channel->period, now);
+                schedule(channel);
+            }
+            tckRestoreInterrupts(primask);
+
+            channel->callback();
+#if defined(ENABLE_TIMER_STATS)
+            if (channel->isOverdue()) channel->stats.overruns++;
+#endif
+            lock = false;
+            now = TckClock::now(); // the callback might have (re)triggered channels, their startCNT is later than the old now
+        }
+
+        uint32_t primask = tckDisableInterrupts();
+        updateDue();
+        tckRestoreInterrupts(primask);
+    }
+
+    void TCK_t::updateDue() // call with interrupts disabled
+    {
+        uint64_t now = TckClock::now();
+        setDue(now, head != nullptr ? remaining(head, now) : maxDueTicks);
+    }
+
+#elif TCK_SCHEDULER == TCK_SCHEDULER_WHEEL
+
+    void TCK_t::dispatch()
+    {
+        static bool lock = false;
+        if (lock) return;
+
+        uint32_t primask = tckDisableInterrupts();
+        uint64_t now = TckClock::now();
+        while (TckWheel::advance((uint32_t)now))
+        {
+            lock = true;
+            TckChannel* channel;
+            while ((channel = TckWheel::nextExpired()) != nullptr)
+            {
+                if (remaining(channel, now) != 0) // period exceeds the range of the wheel, not yet due
+                {
+                    TckWheel::insert(channel, now);
+                    continue;
+                }
+                channel->triggered = channel->periodic; // i.e., stays triggerd if periodic, stops if oneShot
+#if defined(ENABLE_TIMER_STATS)
+                channel->stats.record(TckCounter::read() - (uint32_t)(channel->startCNT + channel->period)); // before rearming
+#endif
+                missed = 0;
+                if (channel->periodic)
+                {
+                    missed = tckRearm(channel->startCNT, channel->period, now);
+                    TckWheel::insert(channel, now);
+                }
+                tckRestoreInterrupts(primask);
+
+                channel->callback();
+#if defined(ENABLE_TIMER_STATS)
+                if (channel->isOverdue()) channel->stats.overruns++;
+#endif
+                primask = tckDisableInterrupts();
+                now = TckClock::now(); // the callback might have (re)triggered channels and advanced the wheel
+            }
+            lock = false;
+        }
+        updateDue();
+        tckRestoreInterrupts(primask);
+    }
+
+    void TCK_t::updateDue() // call with interrupts disabled
+    {
+        TckWheel::nextDue(dueCNT, dueTicks);
+        if (dueTicks > maxDueTicks) dueTicks = maxDueTicks;
+    }
+
+#else
+
+    void TCK_t::dispatch()
     {
         for (unsigned i = 0; i < NR_OF_TCK_TIMERS; i++)
         {
             if (channels[i] != nullptr)
             {
-                channels[i]->tick();
+                channels[i]->tick(TckClock::now()); // fresh time, callbacks of the previous channels might have triggered this one
+            }
+        }
+
+        uint32_t primask = tckDisableInterrupts();
+        updateDue();
+        tckRestoreInterrupts(primask);
+    }
+
+    void TCK_t::updateDue() // call with interrupts disabled
+    {
+        uint64_t now = TckClock::now();
+        uint64_t next = maxDueTicks;
+        for (unsigned i = 0; i < NR_OF_TCK_TIMERS; i++)
+        {
+            TckChannel* channel = channels[i];
+            if (channel != nullptr && channel->triggered && channel->period != 0)
+            {
+                uint64_t r = remaining(channel, now);
+                if (r < next) next = r;
+            }
+        }
+        setDue(now, next);
+    }
+
+#endif
+
+    // inserts a running channel into the deadline list (wheel), a channel which is already scheduled will be moved
+    void TCK_t::schedule(TckChannel* channel)
+    {
+#if TCK_SCHEDULER == TCK_SCHEDULER_SORTED
+        uint32_t primask = tckDisableInterrupts();
+
+        unschedule(channel);
+        if (channel->period == 0) // never expires, see TckChannel::tick
+        {
+            tckRestoreInterrupts(primask);
+            return;
+        }
+
+        uint64_t now = TckClock::now();
+        uint64_t due = remaining(channel, now);
+
+        TckChannel** link = &head; // find the first channel which is due later than the new one
+        while (*link != nullptr && remaining(*link, now) <= due)
+        {
+            link = &(*link)->next;
+        }
+        channel->next = *link;
+        *link = channel;
+        if (head == channel) updateDue();
+
+        tckRestoreInterrupts(primask);
+
+#elif TCK_SCHEDULER == TCK_SCHEDULER_WHEEL
+        uint32_t primask = tckDisableInterrupts();
+        TckWheel::remove(channel);
+        if (channel->period != 0) TckWheel::insert(channel, TckClock::now());
+        updateDue();
+        tckRestoreInterrupts(primask);
+
+#else
+        if (channel->period == 0) return; // never expires, see TckChannel::tick
+
+        uint32_t primask = tckDisableInterrupts();
+        uint64_t now = TckClock::now();
+        uint32_t elapsed = (uint32_t)now - dueCNT;
+        uint64_t due = remaining(channel, now);
+        if (elapsed < dueTicks && due < dueTicks - elapsed) // channel is due before the cached deadline
+        {
+            setDue(now, due);
+        }
+        tckRestoreInterrupts(primask);
+#endif
+    }
+
+    void TCK_t::unschedule(TckChannel* channel)
+    {
+#if TCK_SCHEDULER == TCK_SCHEDULER_WHEEL
+        uint32_t primask = tckDisableInterrupts();
+        TckWheel::remove(channel);
+        updateDue();
+        tckRestoreInterrupts(primask);
+
+#elif TCK_SCHEDULER == TCK_SCHEDULER_SORTED
+        uint32_t primask = tckDisableInterrupts();
+
+        for (TckChannel** link = &head; *link != nullptr; link = &(*link)->next)
+        {
+            if (*link == channel)
+            {
+                *link = channel->next;
+                channel->next = nullptr;
+                break;
             }
         }
+        updateDue();
+
+        tckRestoreInterrupts(primask);
+
+#else
+        uint32_t primask = tckDisableInterrupts();
+        updateDue();
+        tckRestoreInterrupts(primask);
+#endif
+    }
+
+    // ticks until the channel is due, overdue channels return 0. Also valid for a now older than startCNT
+    uint64_t TCK_t::remaining(const TckChannel* channel, uint64_t now)
+    {
+        uint64_t deadline = channel->startCNT + channel->period;
+        return now >= deadline ? 0 : deadline - now;
+    }
+
+    void TCK_t::setDue(uint64_t now, uint64_t ticks) // call with interrupts disabled
+    {
+        dueCNT = (uint32_t)now;
+        dueTicks = ticks < maxDueTicks ? (uint32_t)ticks : maxDueTicks;
+    }
+
+    // TckChannel members which need to inform the scheduler ==========================
+
+    void TckChannel::tick(uint64_t now) // TCK_SCHEDULER_SCAN
+    {
+        static bool lock = false;
+
+        if (!lock && period != 0 && triggered && now >= startCNT + period) // no wrap if an isr retriggered the channel after now was read
+        {
+            lock = true;
+            triggered = periodic; // i.e., stays triggerd if periodic, stops if oneShot
+#if defined(ENABLE_TIMER_STATS)
+            stats.record(TckCounter::read() - (uint32_t)(startCNT + period)); // before rearming
+#endif
+            TCK_t::missed = periodic ? tckRearm(startCNT, period, now) : 0;
+            callback();
+#if defined(ENABLE_TIMER_STATS)
+            if (isOverdue()) stats.overruns++;
+#endif
+            lock = false;
+        }
+    }
+
+    errorCode TckChannel::begin(ChannelCallback cb, uint32_t period, bool periodic)
+    {
+        return beginTicks(cb, (uint64_t)period * TckCounter::ticksPerMicrosecond, periodic);
+    }
+
+    errorCode TckChannel::begin(ChannelCallback cb, float period, bool periodic)
+    {
+        return beginTicks(cb, period * TckCounter::ticksPerMicrosecond, periodic);
+    }
+
+    errorCode TckChannel::beginTicks(ChannelCallback cb, uint64_t ticks, bool periodic)
+    {
+        TCK_t::unschedule(this);
+
+        triggered = false;
+        this->periodic = periodic;
+        this->period = ticks;
+        this->callback = cb;
+
+        startCNT = TckClock::now();
+
+        return errorCode::OK;
+    }
+
+    void TckChannel::start()
+    {
+        this->startCNT = TckClock::now();
+        this->triggered = true;
+        TCK_t::schedule(this);
+    }
+
+    errorCode TckChannel::stop()
+    {
+        this->triggered = false;
+        TCK_t::unschedule(this);
+        return errorCode::OK;
+    }
+
+    errorCode TckChannel::trigger(uint32_t delay) // µs
+    {
+        return triggerTicks((uint64_t)delay * TckCounter::ticksPerMicrosecond);
+    }
+
+    errorCode TckChannel::trigger(float delay) // µs
+    {
+        return triggerTicks(delay * TckCounter::ticksPerMicrosecond);
+    }
+
+    errorCode TckChannel::triggerTicks(uint64_t ticks)
+    {
+        this->startCNT = TckClock::now();
+        this->period = ticks > TckCounter::triggerCorrection ? ticks - TckCounter::triggerCorrection : 1; // period 0 would never expire
+        this->triggered = true;
+        TCK_t::schedule(this);
+
+        return errorCode::OK;
+    }
+
+    errorCode TckChannel::setPeriodTicks(uint64_t ticks)
+    {
+        period = ticks; // measured from the last expiry, i.e., the phase is kept
+        if (triggered) TCK_t::schedule(this); // deadline changed
+        return errorCode::OK;
     }
 }
+
+#endif
@@ -2,13 +2,12 @@
 
 #include "../../ITimerChannel.h"
 #include "ErrorHandling/error_codes.h"
-#include "core_pins.h"
+#include "TckClock.h"
 
 namespace TeensyTimerTool
 {
     class TCK_t;
-
-#if defined(ARDUINO_TEENSYLC) // quick hack for T-LC, should be improved later (using systick?)
+    class TckWheel;
 
     class TckChannel : public ITimerChannel
     {
@@ -16,163 +15,58 @@ namespace TeensyTimerTool
         inline TckChannel() { triggered = false; }
         inline virtual ~TckChannel(){};
 
-        inline errorCode begin(callback_t cb, uint32_t period, bool periodic)
-        {
-            triggered = false;
-            this->periodic = periodic;
-            this->period = period;
-            this->callback = cb;
+        inline errorCode begin(ChannelCallback cb, uint32_t period, bool periodic) override;
+        inline errorCode begin(ChannelCallback cb, float period, bool periodic) override; // µs, allows periods > 0xFFFF'FFFF µs
+        inline void start() override;
+        inline errorCode stop() override;
 
-            startCNT = micros();
+        inline errorCode setPeriodTicks(uint64_t ticks) override;
+        inline uint32_t getPeriod(void) override;
 
-            return errorCode::OK;
-        }
-
-        inline void start()
-        {
-            this->startCNT = micros();
-            this->triggered = true;
-        }
-
-        inline errorCode stop()
-        {
-            this->triggered = false;
-            return errorCode::OK;
-        }
+        inline errorCode trigger(uint32_t delay) override; // µs
+        inline errorCode trigger(float delay) override;    // µs
 
-        inline void setPeriod(uint32_t microSeconds);
-        inline uint32_t getPeriod(void);
+        inline errorCode beginTicks(ChannelCallback cb, uint64_t ticks, bool periodic) override;
+        inline errorCode triggerTicks(uint64_t ticks) override;
+        inline uint64_t ticksFromMicros(uint32_t micros) override { return (uint64_t)micros * TckCounter::ticksPerMicrosecond; }
+        inline uint64_t ticksFromMicros(float micros) override { return micros * TckCounter::ticksPerMicrosecond; }
+        inline uint64_t ticksFromNanos(uint64_t nanos) override { return nanos / 1000 * TckCounter::ticksPerMicrosecond + nanos % 1000 * TckCounter::ticksPerMicrosecond / 1000; }
 
-        inline errorCode trigger(uint32_t delay) // µs
+        inline float getMaxPeriod() override
         {
-            this->startCNT = micros();
-            this->period = delay;
-            this->triggered = true;
-            return errorCode::OK;
+            return 0xFFFF'FFFF'FFFF'FFFF / (TckCounter::ticksPerMicrosecond * 1E6f);
         }
 
      protected:
-        uint32_t startCNT, period;
-        callback_t callback;
+        uint64_t startCNT, period; // TckClock ticks
+        ChannelCallback callback;
         bool triggered;
         bool periodic;
 
-        inline void tick();
+        inline void tick(uint64_t now);
         bool block = false;
 
-        friend TCK_t;
-    };
-
-    // IMPLEMENTATION ==============================================
-
-    void TckChannel::tick()
-    {
-        static bool lock = false;
-
-        if (!lock && period != 0 && triggered && (micros() - startCNT) >= period)
-        {
-            lock = true;
-            startCNT = micros();
-            triggered = periodic; // i.e., stays triggerd if periodic, stops if oneShot
-            callback();
-            lock = false;
-        }
-    }
-    void TckChannel::setPeriod(uint32_t microSeconds)
-    {
-        period = microSeconds;
-    }
-    uint32_t TckChannel::getPeriod()
-    {
-        return period;
-    }
-
-#else
-
-    class TckChannel : public ITimerChannel
-    {
-     public:
-        inline TckChannel() { triggered = false; }
-        inline virtual ~TckChannel(){};
-
-        errorCode begin(callback_t cb, uint32_t period, bool periodic)
-        {
-            triggered = false;
-            this->periodic = periodic;
-            this->period = period * (F_CPU / 1'000'000);
-            this->callback = cb;
-
-            startCNT = ARM_DWT_CYCCNT;
-
-            return errorCode::OK;
-        }
-
-        void start()
-        {
-            this->startCNT = ARM_DWT_CYCCNT;
-            this->triggered = true;
-        }
-
-        errorCode stop()
-        {
-            this->triggered = false;
-            return errorCode::OK;
-        }
-
-        inline void setPeriod(uint32_t microSeconds);
-        inline uint32_t getPeriod(void);
-
-        inline errorCode trigger(uint32_t delay) // µs
-        {
-            this->startCNT = ARM_DWT_CYCCNT;
-            this->period = delay * (F_CPU / 1'000'000) - 68;
-            this->triggered = true;
-
-            return errorCode::OK;
-        }
-
-         inline float getMaxPeriod() override
-         {
-             return 1.0f / F_CPU * 0xFFFF'FFFF;
-         }
-
-     protected:
-        uint32_t startCNT, period;
-        callback_t callback;
-        bool triggered;
-        bool periodic;
+#if defined(ENABLE_TIMER_STATS)
+        inline bool isOverdue() const { return triggered && periodic && TckClock::now() - startCNT >= period; } // next period already expired, i.e. overrun
+#endif
 
-        inline void tick();
-        bool block = false;
+        TckChannel* next = nullptr; // deadline list / wheel slot, not used by TCK_SCHEDULER_SCAN
+#if TCK_SCHEDULER == TCK_SCHEDULER_WHEEL
+        TckChannel** pprev = nullptr;
+        uint32_t expires;
+        uint8_t level, index;
+#endif
 
         friend TCK_t;
+        friend TckWheel;
     };
 
     // IMPLEMENTATION ==============================================
+    // (tick, begin, start, stop, trigger and setPeriodTicks need to inform the scheduler, see TCK.h)
 
-    void TckChannel::tick()
-    {
-        static bool lock = false;
-
-        if (!lock && period != 0 && triggered && (ARM_DWT_CYCCNT - startCNT) >= period)
-        {
-            lock = true;
-            startCNT = ARM_DWT_CYCCNT;
-            triggered = periodic; // i.e., stays triggerd if periodic, stops if oneShot
-            callback();
-            lock = false;
-        }
-    }
-
-    void TckChannel::setPeriod(uint32_t microSeconds)
-    {
-        period = microSeconds * (F_CPU / 1'000'000);
-    }
     uint32_t TckChannel::getPeriod()
     {
-        return period * (1'000'000.0f / F_CPU);
+        return period * (1.0f / TckCounter::ticksPerMicrosecond);
     }
 
-#endif
-
 } // namespace TeensyTimerTool
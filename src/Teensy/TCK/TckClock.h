@@ -0,0 +1,90 @@
+#pragma once
+
+#include "../../config.h"
+#include "../hardware.h"
+#include "core_pins.h"
+#include <cstdint>
+
+namespace TeensyTimerTool
+{
+    // Time base of the TCK timers. The T-LC has no cycle counter, it uses micros() instead
+    // (quick hack for T-LC, should be improved later (using systick?))
+#if defined(ARDUINO_TEENSYLC)
+    struct TckCounter
+    {
+        static inline uint32_t read() { return micros(); }
+        static constexpr uint32_t ticksPerMicrosecond = 1;
+        static constexpr uint32_t triggerCorrection = 0;
+    };
+#else
+    struct TckCounter
+    {
+        static inline uint32_t read() { return ARM_DWT_CYCCNT; }
+        static constexpr uint32_t ticksPerMicrosecond = F_CPU / 1'000'000;
+        static constexpr uint32_t triggerCorrection = 68; // compensates the runtime of trigger()
+    };
+#endif
+
+    // TCK channels can be started/stopped from within ISRs, the scheduler state needs to be protected
+    inline uint32_t tckDisableInterrupts()
+    {
+        uint32_t primask = readPrimask();
+        __disable_irq();
+        return primask;
+    }
+
+    inline void tckRestoreInterrupts(uint32_t primask)
+    {
+        if (primask == 0) __enable_irq();
+    }
+
+    // 64 bit extension of the TckCounter (wraps after ~7s @600MHz, ~71min for the T-LC). Wraps are detected
+    // by comparing with the last reading, i.e., the clock needs to be read at least once per counter wrap.
+    // TCK_t::tick() takes care of this as long as it is called regularly.
+    class TckClock
+    {
+     public:
+        static inline uint64_t now();
+
+     protected:
+        static uint32_t lastCNT, wraps;
+    };
+
+    // starts the next period of an expired periodic timer, see TCK_PERIODIC in defaultConfig.h
+    // returns the number of missed periods (TCK_COALESCE only)
+    inline uint32_t tckRearm(uint64_t& startCNT, uint64_t period, uint64_t now)
+    {
+#if TCK_PERIODIC == TCK_RESTART
+        startCNT = now;
+        return 0;
+#elif TCK_PERIODIC == TCK_FIRE_ALL
+        startCNT += period; // a missed deadline is still due and fires on the next tick
+        return 0;
+#else
+        startCNT += period; // start of the next period = deadline which just expired
+        uint64_t late = now - startCNT;
+        if (late < period) return 0;
+
+        uint64_t missed = late / period;
+        startCNT += missed * period; // continue at the next aligned deadline
+    #if TCK_PERIODIC == TCK_COALESCE
+        return missed;
+    #else
+        return 0;
+    #endif
+#endif
+    }
+
+    // IMPLEMENTATION ==================================================================
+
+    uint64_t TckClock::now()
+    {
+        uint32_t primask = tckDisableInterrupts();
+        uint32_t cnt = TckCounter::read();
+        if (cnt < lastCNT) wraps++;
+        lastCNT = cnt;
+        uint64_t now = (uint64_t)wraps << 32 | cnt;
+        tckRestoreInterrupts(primask);
+        return now;
+    }
+}
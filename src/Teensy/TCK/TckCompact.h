@@ -0,0 +1,323 @@
+#pragma once
+
+#include "../../ITimerChannel.h"
+#include "ErrorHandling/error_codes.h"
+#include "TckClock.h"
+
+#if TCK_SCHEDULER == TCK_SCHEDULER_COMPACT
+
+namespace TeensyTimerTool
+{
+    // Compact storage mode of the TCK timers (TCK_SCHEDULER_COMPACT)
+    //
+    // The state of all channels is kept in statically allocated arrays (structure of arrays) in TCK_t.
+    // Running channels are marked in a packed bit mask, tick() only visits the set bits.
+    // No heap is used, the RAM footprint per timer is fixed:
+    // startCNT (8) + period (8) + callback + handle (8) bytes + 3 bits
+
+    class TCK_t;
+
+    // Handle to a compact TCK channel. Only carries the vtable, the channel number is
+    // derived from the position in TCK_t::channels
+    class TckChannel : public ITimerChannel
+    {
+     public:
+        inline errorCode begin(ChannelCallback cb, uint32_t period, bool periodic) override;
+        inline errorCode begin(ChannelCallback cb, float period, bool periodic) override; // µs, allows periods > 0xFFFF'FFFF µs
+        inline void start() override;
+        inline errorCode stop() override;
+
+        inline errorCode setPeriodTicks(uint64_t ticks) override;
+        inline uint32_t getPeriod(void) override;
+
+        inline errorCode trigger(uint32_t delay) override; // µs
+        inline errorCode trigger(float delay) override;    // µs
+
+        inline errorCode beginTicks(ChannelCallback cb, uint64_t ticks, bool periodic) override;
+        inline errorCode triggerTicks(uint64_t ticks) override;
+        inline uint64_t ticksFromMicros(uint32_t micros) override { return (uint64_t)micros * TckCounter::ticksPerMicrosecond; }
+        inline uint64_t ticksFromMicros(float micros) override { return micros * TckCounter::ticksPerMicrosecond; }
+        inline uint64_t ticksFromNanos(uint64_t nanos) override { return nanos / 1000 * TckCounter::ticksPerMicrosecond + nanos % 1000 * TckCounter::ticksPerMicrosecond / 1000; }
+
+        inline float getMaxPeriod() override
+        {
+            return 0xFFFF'FFFF'FFFF'FFFF / (TckCounter::ticksPerMicrosecond * 1E6f);
+        }
+
+     protected:
+        TckChannel() = default;
+
+        inline unsigned nr() const;
+
+        friend TCK_t;
+    };
+
+    class TCK_t
+    {
+     public:
+        static inline ITimerChannel* getTimer();
+        static inline void removeTimer(TckChannel*);
+        static inline void tick();
+        static inline uint32_t missedPeriods() { return missed; } // periods dropped before the running callback (TCK_COALESCE)
+        static inline uint32_t ticksUntilDue(); // until tick() has something to do (at most maxDueTicks), e.g. to sleep or to advance a virtual clock
+
+     protected:
+        static constexpr unsigned nrOfWords = (NR_OF_TCK_TIMERS + 31) / 32;
+
+        static bool isInitialized;
+        static TckChannel channels[NR_OF_TCK_TIMERS];
+        static uint64_t startCNT[NR_OF_TCK_TIMERS];
+        static uint64_t period[NR_OF_TCK_TIMERS];
+        static ChannelCallback callbacks[NR_OF_TCK_TIMERS];
+        static uint32_t allocated[nrOfWords]; // one bit per channel
+        static uint32_t active[nrOfWords];
+        static uint32_t periodic[nrOfWords];
+
+        static inline void activate(unsigned nr);
+        static inline void deactivate(unsigned nr);
+
+        // cached earliest deadline, tick() only dispatches if dueTicks have elapsed since dueCNT
+        static uint32_t dueCNT, dueTicks;
+        static constexpr uint32_t maxDueTicks = 0x8000'0000; // dispatch at least twice per counter wrap to keep TckClock in sync
+        static inline void dispatch();
+        static inline void updateDue();
+
+        static uint32_t missed;
+
+        friend TckChannel;
+    };
+
+    // IMPLEMENTATION ==================================================================
+
+    ITimerChannel* TCK_t::getTimer()
+    {
+        if (!isInitialized)
+        {
+            // enable the cycle counter
+            ARM_DEMCR |= ARM_DEMCR_TRCENA;
+            ARM_DWT_CTRL |= ARM_DWT_CTRL_CYCCNTENA;
+            isInitialized = true;
+        }
+
+        for (unsigned word = 0; word < nrOfWords; word++)
+        {
+            uint32_t free = ~allocated[word];
+            if (free == 0) continue;
+
+            unsigned nr = word * 32 + __builtin_ctz(free);
+            if (nr >= NR_OF_TCK_TIMERS) break;
+
+            allocated[word] |= 1u << (nr % 32);
+            channels[nr].pCallback = &callbacks[nr];
+            return &channels[nr];
+        }
+        return nullptr;
+    }
+
+    void TCK_t::removeTimer(TckChannel* channel)
+    {
+        unsigned nr = channel->nr();
+        deactivate(nr);
+        allocated[nr / 32] &= ~(1u << (nr % 32));
+        callbacks[nr] = nullptr;
+    }
+
+    void TCK_t::tick()
+    {
+        if (TckCounter::read() - dueCNT >= dueTicks) dispatch(); // single compare if nothing is due
+    }
+
+    uint32_t TCK_t::ticksUntilDue()
+    {
+        uint32_t primask = tckDisableInterrupts();
+        uint32_t elapsed = TckCounter::read() - dueCNT;
+        uint32_t ticks = elapsed >= dueTicks ? 0 : dueTicks - elapsed;
+        tckRestoreInterrupts(primask);
+        return ticks;
+    }
+
+    void TCK_t::dispatch()
+    {
+        static bool lock = false;
+        if (lock) return;
+        lock = true;
+
+        for (unsigned word = 0; word < nrOfWords; word++)
+        {
+            uint32_t pending = active[word];
+            while (pending != 0)
+            {
+                unsigned bit = __builtin_ctz(pending);
+                pending &= pending - 1; // clear lowest set bit
+                unsigned nr = word * 32 + bit;
+                uint32_t mask = 1u << bit;
+
+                uint32_t primask = tckDisableInterrupts(); // channel might have been stopped or retriggered in the meantime
+                uint64_t now = TckClock::now();            // e.g. by the callbacks of the previous channels
+                bool due = (active[word] & mask) && period[nr] != 0 && now >= startCNT[nr] + period[nr];
+                if (due)
+                {
+#if defined(ENABLE_TIMER_STATS)
+                    channels[nr].stats.record(TckCounter::read() - (uint32_t)(startCNT[nr] + period[nr])); // before rearming
+#endif
+                    if (periodic[word] & mask)
+                    {
+                        missed = tckRearm(startCNT[nr], period[nr], now);
+                    } else
+                    {
+                        active[word] &= ~mask;
+                        missed = 0;
+                    }
+                }
+                tckRestoreInterrupts(primask);
+
+                if (due)
+                {
+                    callbacks[nr]();
+#if defined(ENABLE_TIMER_STATS)
+                    if ((active[word] & periodic[word] & mask) && TckClock::now() - startCNT[nr] >= period[nr]) channels[nr].stats.overruns++;
+#endif
+                }
+            }
+        }
+
+        uint32_t primask = tckDisableInterrupts();
+        updateDue();
+        tckRestoreInterrupts(primask);
+        lock = false;
+    }
+
+    void TCK_t::updateDue() // call with interrupts disabled
+    {
+        uint64_t now = TckClock::now();
+        uint64_t next = maxDueTicks;
+        for (unsigned word = 0; word < nrOfWords; word++)
+        {
+            for (uint32_t pending = active[word]; pending != 0; pending &= pending - 1)
+            {
+                unsigned nr = word * 32 + __builtin_ctz(pending);
+                if (period[nr] == 0) continue; // never expires
+                uint64_t elapsed = now - startCNT[nr];
+                uint64_t remaining = elapsed >= period[nr] ? 0 : period[nr] - elapsed;
+                if (remaining < next) next = remaining;
+            }
+        }
+        dueCNT = (uint32_t)now;
+        dueTicks = (uint32_t)next;
+    }
+
+    void TCK_t::activate(unsigned nr)
+    {
+        uint32_t primask = tckDisableInterrupts();
+        active[nr / 32] |= 1u << (nr % 32);
+
+        if (period[nr] != 0) // period 0 never expires
+        {
+            uint64_t now = TckClock::now();
+            uint64_t elapsed = now - startCNT[nr];
+            uint64_t due = elapsed >= period[nr] ? 0 : period[nr] - elapsed;
+            uint32_t sinceDue = (uint32_t)now - dueCNT;
+            if (sinceDue < dueTicks && due < dueTicks - sinceDue) // channel is due before the cached deadline
+            {
+                dueCNT = (uint32_t)now;
+                dueTicks = (uint32_t)due;
+            }
+        }
+        tckRestoreInterrupts(primask);
+    }
+
+    // the cached deadline is not raised, a stale deadline only leads to one dispatch which recalculates it
+    void TCK_t::deactivate(unsigned nr)
+    {
+        uint32_t primask = tckDisableInterrupts();
+        active[nr / 32] &= ~(1u << (nr % 32));
+        tckRestoreInterrupts(primask);
+    }
+
+    // TckChannel ======================================================================
+
+    unsigned TckChannel::nr() const
+    {
+        return this - TCK_t::channels;
+    }
+
+    errorCode TckChannel::begin(ChannelCallback cb, uint32_t period, bool periodic)
+    {
+        return beginTicks(cb, (uint64_t)period * TckCounter::ticksPerMicrosecond, periodic);
+    }
+
+    errorCode TckChannel::begin(ChannelCallback cb, float period, bool periodic)
+    {
+        return beginTicks(cb, period * TckCounter::ticksPerMicrosecond, periodic);
+    }
+
+    errorCode TckChannel::beginTicks(ChannelCallback cb, uint64_t ticks, bool periodic)
+    {
+        unsigned nr = this->nr();
+        uint32_t mask = 1u << (nr % 32);
+
+        TCK_t::deactivate(nr);
+        if (periodic)
+            TCK_t::periodic[nr / 32] |= mask;
+        else
+            TCK_t::periodic[nr / 32] &= ~mask;
+        TCK_t::period[nr] = ticks;
+        TCK_t::callbacks[nr] = cb;
+        TCK_t::startCNT[nr] = TckClock::now();
+
+        return errorCode::OK;
+    }
+
+    void TckChannel::start()
+    {
+        unsigned nr = this->nr();
+        TCK_t::startCNT[nr] = TckClock::now();
+        TCK_t::activate(nr);
+    }
+
+    errorCode TckChannel::stop()
+    {
+        TCK_t::deactivate(nr());
+        return errorCode::OK;
+    }
+
+    errorCode TckChannel::trigger(uint32_t delay) // µs
+    {
+        return triggerTicks((uint64_t)delay * TckCounter::ticksPerMicrosecond);
+    }
+
+    errorCode TckChannel::trigger(float delay) // µs
+    {
+        return triggerTicks(delay * TckCounter::ticksPerMicrosecond);
+    }
+
+    errorCode TckChannel::triggerTicks(uint64_t ticks)
+    {
+        unsigned nr = this->nr();
+        TCK_t::deactivate(nr); // don't expire while the deadline is updated
+        TCK_t::startCNT[nr] = TckClock::now();
+        TCK_t::period[nr] = ticks > TckCounter::triggerCorrection ? ticks - TckCounter::triggerCorrection : 1; // period 0 would never expire
+        TCK_t::activate(nr);
+
+        return errorCode::OK;
+    }
+
+    errorCode TckChannel::setPeriodTicks(uint64_t ticks)
+    {
+        unsigned nr = this->nr();
+        uint32_t primask = tckDisableInterrupts();
+        TCK_t::period[nr] = ticks; // measured from the last expiry, i.e., the phase is kept
+        bool running = TCK_t::active[nr / 32] & (1u << (nr % 32));
+        tckRestoreInterrupts(primask);
+
+        if (running) TCK_t::activate(nr); // deadline changed
+        return errorCode::OK;
+    }
+
+    uint32_t TckChannel::getPeriod()
+    {
+        return TCK_t::period[nr()] * (1.0f / TckCounter::ticksPerMicrosecond);
+    }
+}
+
+#endif
@@ -0,0 +1,224 @@
+#pragma once
+
+#include "TckChannel.h"
+
+#if TCK_SCHEDULER == TCK_SCHEDULER_WHEEL
+
+namespace TeensyTimerTool
+{
+    constexpr unsigned tckLog2(uint32_t x) { return x > 1 ? 1 + tckLog2(x / 2) : 0; }
+
+    // Hierarchical timing wheel used by TCK_SCHEDULER_WHEEL.
+    //
+    // The counter is divided into slots of 2^slotShift ticks (roughly 1µs). Level 0 holds the channels
+    // which expire within the next 64 slots, level 1 the ones expiring within 64^2 slots and so on.
+    // Whenever level 0 completes a rotation the due slot of the next level is redistributed to the
+    // lower levels. Insert, cancel and expiry are O(1).
+    // Channels expire at the end of their slot, i.e. up to one slot late but never early.
+    // All functions need to be called with interrupts disabled.
+
+    class TckWheel
+    {
+     public:
+        static inline void begin();
+        static inline void insert(TckChannel*, uint64_t now);
+        static inline void remove(TckChannel*);
+        static inline void nextDue(uint32_t& startCNT, uint32_t& ticks);
+        static inline bool advance(uint32_t now);
+        static inline TckChannel* nextExpired();
+
+     protected:
+        static constexpr unsigned slotShift = tckLog2(TckCounter::ticksPerMicrosecond);
+        static constexpr unsigned levelBits = 6;
+        static constexpr unsigned slotsPerLevel = 1 << levelBits;
+        static constexpr unsigned nrOfLevels = (32 - slotShift) / levelBits + 1; // covers periods up to 0xFFFF'FFFF ticks
+        static constexpr uint8_t detached = 0xFF;                                // level marker for channels in the expiry list
+
+        static TckChannel* slots[nrOfLevels][slotsPerLevel];
+        static uint64_t occupied[nrOfLevels]; // one bit per non empty slot
+        static uint32_t wheelTime;            // next slot to be processed
+        static uint32_t wheelCNT;             // counter value at the start of slot wheelTime
+        static unsigned armed;                // number of channels in the wheel
+        static TckChannel* expired;           // channels of the last due slot
+
+        static inline void link(TckChannel*, TckChannel** head);
+        static inline void place(TckChannel*);
+        static inline void cascade(unsigned level, unsigned index);
+    };
+
+    // IMPLEMENTATION ==================================================================
+
+    void TckWheel::begin()
+    {
+        for (unsigned level = 0; level < nrOfLevels; level++)
+        {
+            for (unsigned i = 0; i < slotsPerLevel; i++) slots[level][i] = nullptr;
+            occupied[level] = 0;
+        }
+        armed = 0;
+        expired = nullptr;
+        wheelTime = 0;
+        wheelCNT = TckCounter::read();
+    }
+
+    // channels due later than the range of the wheel are inserted with the maximum delay and need to be
+    // reinserted if they are not yet due on expiry
+    void TckWheel::insert(TckChannel* channel, uint64_t now)
+    {
+        if (armed == 0) wheelCNT = (uint32_t)now; // empty wheel might not have been advanced for a while (even > 2^31 ticks), sync to counter
+
+        uint64_t deadline = channel->startCNT + channel->period;
+        uint64_t remaining = now >= deadline ? 0 : deadline - now;
+        if (remaining > 0xFFFF'FFFF) remaining = 0xFFFF'FFFF;
+
+        // ticks from start of current slot to deadline. In dispatch, now can be older than the wheel if a callback
+        // inserted into the empty wheel in the meantime, the channel is due then.
+        int64_t ticks = (int32_t)((uint32_t)now - wheelCNT) + (int64_t)remaining;
+        if (ticks < 0) ticks = 0;
+        channel->expires = wheelTime + (uint32_t)((uint64_t)ticks >> slotShift);
+        place(channel);
+        armed++;
+    }
+
+    void TckWheel::remove(TckChannel* channel)
+    {
+        if (channel->pprev == nullptr) return; // not in the wheel
+
+        *channel->pprev = channel->next;
+        if (channel->next != nullptr) channel->next->pprev = channel->pprev;
+
+        if (channel->level != detached && slots[channel->level][channel->index] == nullptr)
+        {
+            occupied[channel->level] &= ~(1ULL << channel->index);
+        }
+        channel->next = nullptr;
+        channel->pprev = nullptr;
+        armed--;
+    }
+
+    // advances the wheel up to the next due slot and moves its channels to the expired list.
+    // Returns false if no slot is due.
+    bool TckWheel::advance(uint32_t now)
+    {
+        uint32_t nrOfSlots = (now - wheelCNT) >> slotShift; // completed slots since last call
+        if (nrOfSlots == 0) return false;
+
+        if (armed == 0) // nothing to do, just follow the counter
+        {
+            wheelTime += nrOfSlots;
+            wheelCNT += nrOfSlots << slotShift;
+            return false;
+        }
+
+        while (nrOfSlots > 0)
+        {
+            unsigned index = wheelTime & (slotsPerLevel - 1);
+            if (index == 0) // level 0 completed a rotation, redistribute the next slot of the upper levels
+            {
+                for (unsigned level = 1; level < nrOfLevels; level++)
+                {
+                    unsigned upperIndex = (wheelTime >> (level * levelBits)) & (slotsPerLevel - 1);
+                    cascade(level, upperIndex);
+                    if (upperIndex != 0) break;
+                }
+            }
+
+            uint64_t pending = occupied[0] >> index;
+            if (pending & 1) // current slot is due
+            {
+                wheelTime++;
+                wheelCNT += 1 << slotShift;
+
+                expired = slots[0][index];
+                slots[0][index] = nullptr;
+                occupied[0] &= ~(1ULL << index);
+                expired->pprev = &expired;
+                for (TckChannel* channel = expired; channel != nullptr; channel = channel->next) channel->level = detached;
+                return true;
+            }
+
+            // skip empty slots up to the next used one or the end of the rotation
+            uint32_t distance = pending != 0 ? __builtin_ctzll(pending) : slotsPerLevel - index;
+            if (distance > nrOfSlots) distance = nrOfSlots;
+            wheelTime += distance;
+            wheelCNT += distance << slotShift;
+            nrOfSlots -= distance;
+        }
+        return false;
+    }
+
+    // end of the next used level 0 slot (or of the first slot of the next rotation which redistributes the
+    // upper levels), 'never' if the wheel is empty.
+    void TckWheel::nextDue(uint32_t& startCNT, uint32_t& ticks)
+    {
+        startCNT = wheelCNT;
+        if (armed == 0)
+        {
+            ticks = 0xFFFF'FFFF;
+            return;
+        }
+
+        unsigned index = wheelTime & (slotsPerLevel - 1);
+        uint64_t pending = occupied[0] >> index;
+        uint32_t nrOfSlots;
+        if (index == 0) // upper levels not yet redistributed
+            nrOfSlots = 1;
+        else
+            nrOfSlots = pending != 0 ? __builtin_ctzll(pending) + 1 : slotsPerLevel - index + 1;
+
+        ticks = nrOfSlots << slotShift;
+    }
+
+    // removes and returns the next channel from the expired list, nullptr if empty
+    TckChannel* TckWheel::nextExpired()
+    {
+        TckChannel* channel = expired;
+        if (channel != nullptr) remove(channel);
+        return channel;
+    }
+
+    void TckWheel::link(TckChannel* channel, TckChannel** head)
+    {
+        channel->next = *head;
+        if (*head != nullptr) (*head)->pprev = &channel->next;
+        channel->pprev = head;
+        *head = channel;
+    }
+
+    void TckWheel::place(TckChannel* channel)
+    {
+        uint32_t delta = channel->expires - wheelTime;
+        unsigned level = 0;
+        unsigned index;
+
+        if ((int32_t)delta < 0) // already due
+        {
+            index = wheelTime & (slotsPerLevel - 1);
+        } else
+        {
+            while (level < nrOfLevels - 1 && delta >= (1ULL << ((level + 1) * levelBits))) level++;
+            index = (channel->expires >> (level * levelBits)) & (slotsPerLevel - 1);
+        }
+
+        channel->level = level;
+        channel->index = index;
+        link(channel, &slots[level][index]);
+        occupied[level] |= 1ULL << index;
+    }
+
+    void TckWheel::cascade(unsigned level, unsigned index)
+    {
+        TckChannel* channel = slots[level][index];
+        slots[level][index] = nullptr;
+        occupied[level] &= ~(1ULL << index);
+
+        while (channel != nullptr)
+        {
+            TckChannel* next = channel->next;
+            place(channel);
+            channel = next;
+        }
+    }
+}
+
+#endif
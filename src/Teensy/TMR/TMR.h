@@ -1,5 +1,8 @@
 #pragma once
 
+#include "../ChannelStorage.h"
+#include "../hardware.h"
+#include "TMRCascadeChannel.h"
 #include "TMRChannel.h"
 #include "imxrt.h"
 
@@ -10,19 +13,36 @@ namespace TeensyTimerTool
     {
      public:
         static ITimerChannel* getTimer(); 
+        static ITimerChannel* getCascadedTimer(); // channel pair 0/1 or 2/3 used as one 32bit timer at 150MHz
+
+        template <unsigned chNr, void (*handler)()>
+        static ITimerChannel* getStaticTimer(); // channel chNr, serviced by a dedicated isr which calls handler directly
+
+        static constexpr uint64_t clockHz = 150'000'000 >> (TMR_DEFAULT_PSC == PSC_AUTO ? 0 : TMR_DEFAULT_PSC); // for compile time conversion of ConstDurations
+        static constexpr uint64_t maxTicks = TMR_DEFAULT_PSC == PSC_AUTO ? 0xFFFFull << 7 : 0xFFFF;
 
      protected:
         static bool isInitialized;
+        static bool hasStaticIsr;
+        static uint32_t allocated; // channels handed out by getTimer (one bit per channel), serviced by isr()
+        static uint32_t reserved;  // all channels in use, including static channels and the lower channels of cascaded pairs
+        static void init();
         static void isr();
-        static callback_t callbacks[4];
+        template <unsigned chNr, void (*handler)()>
+        static void staticIsr();
+        static ChannelCallback callbacks[4];
+        static ChannelStorage<TMRChannel, 4> channels;
+        static ChannelStorage<TMRCascadeChannel, 2> cascadedChannels;
+
+#if defined(ENABLE_TIMER_STATS)
+        static TimerStats* stats[4]; // of the channel serviced at chNr, i.e. the upper channel of cascaded pairs
+        static inline void recordLateness(unsigned chNr);
+        static inline void recordOverrun(unsigned chNr);
+#endif
 
         // the following is calculated at compile time
         static constexpr IRQ_NUMBER_t irq = moduleNr == 0 ? IRQ_QTIMER1 : moduleNr == 1 ? IRQ_QTIMER2 : moduleNr == 2 ? IRQ_QTIMER3 : IRQ_QTIMER4;       
         static IMXRT_TMR_t* const pTMR;
-        static IMXRT_TMR_CH_t* const pCH0;
-        static IMXRT_TMR_CH_t* const pCH1;
-        static IMXRT_TMR_CH_t* const pCH2;
-        static IMXRT_TMR_CH_t* const pCH3;
 
         static_assert(moduleNr < 4, "Module number < 4 required");
     };
@@ -30,71 +50,194 @@ namespace TeensyTimerTool
     // IMPLEMENTATION ==================================================================
 
     template <unsigned moduleNr> IMXRT_TMR_t*    const TMR_t<moduleNr>::pTMR = moduleNr == 0 ? &IMXRT_TMR1 : moduleNr == 1 ? &IMXRT_TMR2 : moduleNr == 2 ? &IMXRT_TMR3 : &IMXRT_TMR4;
-    template <unsigned moduleNr> IMXRT_TMR_CH_t* const TMR_t<moduleNr>::pCH0 = &pTMR->CH[0]; 
-    template <unsigned moduleNr> IMXRT_TMR_CH_t* const TMR_t<moduleNr>::pCH1 = &pTMR->CH[1];
-    template <unsigned moduleNr> IMXRT_TMR_CH_t* const TMR_t<moduleNr>::pCH2 = &pTMR->CH[2];
-    template <unsigned moduleNr> IMXRT_TMR_CH_t* const TMR_t<moduleNr>::pCH3 = &pTMR->CH[3];
+
+    template <unsigned moduleNr>
+    void TMR_t<moduleNr>::init()
+    {
+        for (unsigned chNr = 0; chNr < 4; chNr++)
+        {
+            pTMR->CH[chNr].CTRL = 0x0000;
+            callbacks[chNr] = nullptr;
+        }
+        attachInterruptVector(irq, isr); // start
+        NVIC_ENABLE_IRQ(irq);
+        isInitialized = true;
+    }
 
     template <unsigned moduleNr>
     ITimerChannel* TMR_t<moduleNr>::getTimer()
     {
-        if (!isInitialized)
+        if (!isInitialized) init();
+
+        for (unsigned chNr = 0; chNr < 4; chNr++)
         {
-            for (unsigned chNr = 0; chNr < 4; chNr++)
+            IMXRT_TMR_CH_t* pCh = &pTMR->CH[chNr];
+            if (!(reserved & (1 << chNr)) && pCh->CTRL == 0x0000)
             {
-                pTMR->CH[chNr].CTRL = 0x0000;
-                callbacks[chNr] = nullptr;
+                allocated |= 1 << chNr;
+                reserved |= 1 << chNr;
+                ITimerChannel* channel = channels.construct(chNr, pCh, &callbacks[chNr]);
+#if defined(ENABLE_TIMER_STATS)
+                stats[chNr] = &channel->stats;
+#endif
+                return channel;
             }
-            attachInterruptVector(irq, isr); // start
-            NVIC_ENABLE_IRQ(irq);
-            isInitialized = true;
-            return new TMRChannel(pCH0, &callbacks[0]);
         }
+        return nullptr;
+    }
 
-        for (unsigned chNr = 0; chNr < 4; chNr++)
+    // The upper channel of the pair requests the interrupt and is serviced by isr(), the lower channel only counts
+    template <unsigned moduleNr>
+    ITimerChannel* TMR_t<moduleNr>::getCascadedTimer()
+    {
+        if (!isInitialized) init();
+
+        for (unsigned lowNr = 0; lowNr < 4; lowNr += 2)
         {
-            IMXRT_TMR_CH_t* pCh = &pTMR->CH[chNr];
-            if (pCh->CTRL == 0x0000)
+            unsigned highNr = lowNr + 1;
+            uint32_t pair = (1 << lowNr) | (1 << highNr);
+            if (!(reserved & pair) && pTMR->CH[lowNr].CTRL == 0x0000 && pTMR->CH[highNr].CTRL == 0x0000)
             {
-                return new TMRChannel(pCh, &callbacks[chNr]);
+                allocated |= 1 << highNr;
+                reserved |= pair;
+                ITimerChannel* channel = cascadedChannels.construct(lowNr / 2, &pTMR->CH[lowNr], &pTMR->CH[highNr], lowNr, &callbacks[highNr]);
+#if defined(ENABLE_TIMER_STATS)
+                stats[highNr] = &channel->stats;
+#endif
+                return channel;
             }
         }
         return nullptr;
     }
 
+    // The channel keeps a null callback, i.e., it is skipped by the generic isr.
+    // Only one static channel per module since it replaces the interrupt vector of the module.
+    template <unsigned moduleNr>
+    template <unsigned chNr, void (*handler)()>
+    ITimerChannel* TMR_t<moduleNr>::getStaticTimer()
+    {
+        static_assert(chNr < 4, "Channel number < 4 required");
+
+        if (!isInitialized) init();
+        if (hasStaticIsr || (reserved & (1 << chNr)) || pTMR->CH[chNr].CTRL != 0x0000) return nullptr;
+
+        hasStaticIsr = true;
+        reserved |= 1 << chNr;
+        attachInterruptVector(irq, staticIsr<chNr, handler>);
+        ITimerChannel* channel = channels.construct(chNr, &pTMR->CH[chNr], &callbacks[chNr]);
+#if defined(ENABLE_TIMER_STATS)
+        stats[chNr] = &channel->stats;
+#endif
+        return channel;
+    }
+
     template <unsigned m>
     void TMR_t<m>::isr()
     {
-        // no loop to gain some time by avoiding indirections and pointer calculations
-        if (callbacks[0] != nullptr && pCH0->CSCTRL & TMR_CSCTRL_TCF1)
+        // the QTimer has no common flag register, only the CSCTRL of allocated channels is read
+        for (uint32_t pending = allocated; pending != 0; pending &= pending - 1)
         {
-            pCH0->CSCTRL &= ~TMR_CSCTRL_TCF1;
-            callbacks[0]();
+            unsigned chNr = __builtin_ctz(pending);
+            IMXRT_TMR_CH_t* pCh = &pTMR->CH[chNr];
+            uint16_t csctrl = pCh->CSCTRL;
+            if ((csctrl & TMR_CSCTRL_TCF1) && callbacks[chNr] != nullptr)
+            {
+                pCh->CSCTRL = csctrl & ~TMR_CSCTRL_TCF1; // write back the value read above, saves a second bus read
+#if defined(ENABLE_TIMER_STATS)
+                recordLateness(chNr);
+#endif
+                callbacks[chNr]();
+#if defined(ENABLE_TIMER_STATS)
+                recordOverrun(chNr);
+#endif
+            }
         }
+        dataSyncBarrier();
+    }
 
-        if (callbacks[1] != nullptr && pCH1->CSCTRL & TMR_CSCTRL_TCF1)
+    template <unsigned m>
+    template <unsigned chNr, void (*handler)()>
+    void TMR_t<m>::staticIsr()
+    {
+        IMXRT_TMR_CH_t* const pCH = &pTMR->CH[chNr];
+        uint16_t csctrl = pCH->CSCTRL;
+        if (csctrl & TMR_CSCTRL_TCF1)
         {
-            pCH1->CSCTRL &= ~TMR_CSCTRL_TCF1;
-            callbacks[1]();
+            pCH->CSCTRL = csctrl & ~TMR_CSCTRL_TCF1;
+#if defined(ENABLE_TIMER_STATS)
+            recordLateness(chNr);
+#endif
+            handler(); // known at compile time, can be inlined
+#if defined(ENABLE_TIMER_STATS)
+            recordOverrun(chNr);
+#endif
         }
 
-        if (callbacks[2] != nullptr && pCH2->CSCTRL & TMR_CSCTRL_TCF1)
-        {
-            pCH2->CSCTRL &= ~TMR_CSCTRL_TCF1;
-            callbacks[2]();
-        }
+        if (allocated != 0) // other channels of the module in use
+            isr();
+        else
+            dataSyncBarrier();
+    }
 
-        if (callbacks[3] != nullptr && pCH3->CSCTRL & TMR_CSCTRL_TCF1)
+#if defined(ENABLE_TIMER_STATS)
+    // The counters show the compare value until the next tick and restart from LOAD = 0 then (LENGTH).
+    // One shot channels (ONCE) stop at the compare, their lateness is not known and not recorded.
+    template <unsigned m>
+    void TMR_t<m>::recordLateness(unsigned chNr)
+    {
+        IMXRT_TMR_CH_t* pCh = &pTMR->CH[chNr];
+        uint16_t ctrl = pCh->CTRL;
+        if (ctrl & TMR_CTRL_ONCE) return;
+
+        uint32_t cnt, cmp;
+        unsigned psc = 0;
+        if ((ctrl & TMR_CTRL_CM(7)) == TMR_CTRL_CM(7)) // upper channel of a cascaded pair, counts the compares of the lower one
         {
-            pCH3->CSCTRL &= ~TMR_CSCTRL_TCF1;
-            callbacks[3]();
+            uint16_t hi;
+            do
+            {
+                hi = pCh->CNTR;
+                cnt = (uint32_t)hi << 16 | pTMR->CH[chNr - 1].CNTR;
+            } while (pCh->CNTR != hi); // lower channel wrapped in between
+            cmp = (uint32_t)pCh->COMP1 << 16 | pTMR->CH[chNr - 1].COMP1;
+        } else
+        {
+            psc = (ctrl >> 9) & 0b111; // PCS = 0b1000 | psc
+            cnt = pCh->CNTR;
+            cmp = pCh->COMP1;
         }
-        asm volatile("dsb"); //wait until register changes propagated through the cache
+        uint32_t ticks = cnt == cmp ? 0 : cnt + 1;
+        stats[chNr]->record(((uint64_t)ticks << psc) * F_CPU / 150'000'000);
+    }
+
+    template <unsigned m>
+    void TMR_t<m>::recordOverrun(unsigned chNr)
+    {
+        if (pTMR->CH[chNr].CSCTRL & TMR_CSCTRL_TCF1) stats[chNr]->overruns++;
     }
 
+    template <unsigned m>
+    TimerStats* TMR_t<m>::stats[4];
+#endif
+
     template <unsigned m>
     bool TMR_t<m>::isInitialized = false;
 
     template <unsigned m>
-    callback_t TMR_t<m>::callbacks[4];
+    bool TMR_t<m>::hasStaticIsr = false;
+
+    template <unsigned m>
+    uint32_t TMR_t<m>::allocated = 0;
+
+    template <unsigned m>
+    uint32_t TMR_t<m>::reserved = 0;
+
+    template <unsigned m>
+    ChannelCallback TMR_t<m>::callbacks[4];
+
+    template <unsigned m>
+    ChannelStorage<TMRChannel, 4> TMR_t<m>::channels;
+
+    template <unsigned m>
+    ChannelStorage<TMRCascadeChannel, 2> TMR_t<m>::cascadedChannels;
 }
@@ -0,0 +1,141 @@
+#pragma once
+#include "../../ITimerChannel.h"
+#include "../TickScale.h"
+#include "Arduino.h"
+#include "ErrorHandling/error_codes.h"
+#include "config.h"
+#include "imxrt.h"
+
+namespace TeensyTimerTool
+{
+    // Two QuadTimer channels of a module combined into one 32bit timer running at the full 150MHz bus clock
+    // (6.7ns resolution, max period ~28.6s). The lower channel counts the bus clock, the upper channel counts
+    // its rollovers (cascade count mode 7). In cascade mode a compare event is only generated if both counters
+    // match, the interrupt is requested by the upper channel.
+
+    class TMRCascadeChannel : public ITimerChannel
+    {
+     public:
+        inline TMRCascadeChannel(IMXRT_TMR_CH_t* lowRegs, IMXRT_TMR_CH_t* highRegs, unsigned lowChNr, ChannelCallback* cbStorage);
+
+        inline errorCode begin(ChannelCallback cb, uint32_t tcnt, bool periodic) override;
+        inline errorCode begin(ChannelCallback cb, float tcnt, bool periodic) override;
+
+        inline errorCode trigger(uint32_t tcnt) override;
+        inline errorCode trigger(float tcnt) override;
+
+        inline errorCode beginTicks(ChannelCallback cb, uint64_t ticks, bool periodic) override;
+        inline errorCode triggerTicks(uint64_t ticks) override;
+        inline uint64_t ticksFromMicros(uint32_t micros) override { return scale.ticks(micros); }
+        inline uint64_t ticksFromMicros(float micros) override { return scale.ticks(micros); }
+        inline uint64_t ticksFromNanos(uint64_t nanos) override { return scale.ticksFromNanos(nanos); }
+
+        inline errorCode setPeriodTicks(uint64_t ticks) override;
+        inline uint32_t getPeriod() override;
+
+        inline float getMaxPeriod() override { return 0xFFFF'FFFE / 150.0f; }
+
+     protected:
+        IMXRT_TMR_CH_t *lowRegs, *highRegs;
+        uint32_t cascadeSrc; // primary count source of the upper channel: output of the lower channel
+        TickScale scale = TickScale(150'000'000);
+
+        inline errorCode start(uint64_t ticks, bool periodic); // begin and trigger
+        inline void load(uint32_t reload, bool periodic);
+    };
+
+    // IMPLEMENTATION ==============================================
+
+    TMRCascadeChannel::TMRCascadeChannel(IMXRT_TMR_CH_t* lowRegs, IMXRT_TMR_CH_t* highRegs, unsigned lowChNr, ChannelCallback* cbStorage)
+        : ITimerChannel(cbStorage)
+    {
+        this->lowRegs = lowRegs;
+        this->highRegs = highRegs;
+        this->cascadeSrc = 0b0100 | lowChNr;
+    }
+
+    errorCode TMRCascadeChannel::begin(ChannelCallback cb, uint32_t tcnt, bool periodic)
+    {
+        return beginTicks(cb, scale.ticks(tcnt), periodic);
+    }
+
+    errorCode TMRCascadeChannel::begin(ChannelCallback cb, float tcnt, bool periodic)
+    {
+        return beginTicks(cb, scale.ticks(tcnt), periodic);
+    }
+
+    errorCode TMRCascadeChannel::beginTicks(ChannelCallback cb, uint64_t ticks, bool periodic)
+    {
+        setCallback(cb);
+        return start(ticks, periodic);
+    }
+
+    errorCode TMRCascadeChannel::trigger(uint32_t tcnt)
+    {
+        return triggerTicks(scale.ticks(tcnt));
+    }
+
+    errorCode TMRCascadeChannel::trigger(float tcnt)
+    {
+        return triggerTicks(scale.ticks(tcnt));
+    }
+
+    errorCode TMRCascadeChannel::triggerTicks(uint64_t ticks)
+    {
+        return start(ticks, false);
+    }
+
+    // both halves are preloaded, a compare between the two writes would use one mixed period
+    errorCode TMRCascadeChannel::setPeriodTicks(uint64_t ticks)
+    {
+        ticks = atLeastOneTick(ticks);
+        uint32_t reload = ticks > 0xFFFF'FFFF ? 0xFFFF'FFFE : (uint32_t)ticks - 1;
+        highRegs->CMPLD1 = reload >> 16;
+        lowRegs->CMPLD1 = reload & 0xFFFF;
+
+        return ticks > 0xFFFF'FFFF ? postError(errorCode::periodOverflow) : errorCode::OK;
+    }
+
+    uint32_t TMRCascadeChannel::getPeriod()
+    {
+        uint32_t reload = (highRegs->CMPLD1 << 16) | lowRegs->CMPLD1;
+        return (reload + 1.0f) / scale.ticksPerMicrosecond();
+    }
+
+    errorCode TMRCascadeChannel::start(uint64_t ticks, bool periodic)
+    {
+        ticks = atLeastOneTick(ticks);
+        if (ticks > 0xFFFF'FFFF)
+        {
+            load(0xFFFF'FFFE, periodic);
+            return postError(errorCode::periodOverflow);
+        }
+        load((uint32_t)ticks - 1, periodic); // counts 0..reload
+        return errorCode::OK;
+    }
+
+    void TMRCascadeChannel::load(uint32_t reload, bool periodic)
+    {
+        lowRegs->CTRL = 0x0000;
+        highRegs->CTRL = 0x0000;
+
+        lowRegs->LOAD = 0x0000;
+        lowRegs->COMP1 = reload & 0xFFFF;
+        lowRegs->CMPLD1 = reload & 0xFFFF;
+        lowRegs->CNTR = 0x0000;
+
+        highRegs->LOAD = 0x0000;
+        highRegs->COMP1 = reload >> 16;
+        highRegs->CMPLD1 = reload >> 16;
+        highRegs->CNTR = 0x0000;
+
+        lowRegs->CSCTRL |= TMR_CSCTRL_CL1(1); // COMP1 is reloaded from CMPLD1 at each compare, see setPeriodTicks
+        highRegs->CSCTRL &= ~TMR_CSCTRL_TCF1;
+        highRegs->CSCTRL |= TMR_CSCTRL_TCF1EN | TMR_CSCTRL_CL1(1);
+
+        // upper channel first, it only counts once the lower channel is running
+        highRegs->CTRL = TMR_CTRL_CM(7) | TMR_CTRL_PCS(cascadeSrc) | TMR_CTRL_LENGTH | (periodic ? 0 : TMR_CTRL_ONCE);
+        lowRegs->CTRL = TMR_CTRL_CM(1) | TMR_CTRL_PCS(0b1000) | TMR_CTRL_LENGTH; // 150MHz
+    }
+
+} // namespace TeensyTimerTool
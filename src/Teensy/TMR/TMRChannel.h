@@ -1,5 +1,6 @@
 #pragma once
 #include "../../ITimerChannel.h"
+#include "../TickScale.h"
 #include "Arduino.h"
 #include "ErrorHandling/error_codes.h"
 #include "config.h"
@@ -10,29 +11,41 @@ namespace TeensyTimerTool
     class TMRChannel : public ITimerChannel
     {
      public:
-        inline TMRChannel(IMXRT_TMR_CH_t* regs, callback_t* cbStorage);
+        inline TMRChannel(IMXRT_TMR_CH_t* regs, ChannelCallback* cbStorage);
         inline virtual ~TMRChannel();
 
-        inline errorCode begin(callback_t cb, uint32_t tcnt, bool periodic) override;
-        inline errorCode begin(callback_t cb, float tcnt, bool periodic) override;
+        inline errorCode begin(ChannelCallback cb, uint32_t tcnt, bool periodic) override;
+        inline errorCode begin(ChannelCallback cb, float tcnt, bool periodic) override;
 
         inline errorCode trigger(uint32_t tcnt) override;
         inline errorCode trigger(float tcnt) override;
 
+        inline errorCode beginTicks(ChannelCallback cb, uint64_t ticks, bool periodic) override;
+        inline errorCode triggerTicks(uint64_t ticks) override;
+        inline uint64_t ticksFromMicros(uint32_t micros) override { return scale.ticks(micros); }
+        inline uint64_t ticksFromMicros(float micros) override { return scale.ticks(micros); }
+        inline uint64_t ticksFromNanos(uint64_t nanos) override { return scale.ticksFromNanos(nanos); }
+
+        inline errorCode setPeriodTicks(uint64_t ticks) override;
+        inline uint32_t getPeriod() override;
+
         inline float getMaxPeriod() override;
-        inline void setPeriod(uint32_t) override {}
-        inline void setPrescaler(uint32_t psc); // psc 0..7 -> prescaler: 1..128
+        inline void setPrescaler(int psc); // psc 0..7 -> prescaler: 1..128, PSC_AUTO: smallest prescaler fitting the period
 
      protected:
         IMXRT_TMR_CH_t* regs;
-        callback_t** pCallback = nullptr;
+        ChannelCallback** pCallback = nullptr;
+        inline void autoPrescaler(uint64_t& ticks);
+
         float pscValue;
         uint32_t pscBits;
+        bool isAutoPsc; // ticks are counted at 150MHz and scaled down by the prescaler chosen in begin / trigger
+        TickScale scale;
     };
 
     // IMPLEMENTATION ==============================================
 
-    TMRChannel::TMRChannel(IMXRT_TMR_CH_t* regs, callback_t* cbStorage)
+    TMRChannel::TMRChannel(IMXRT_TMR_CH_t* regs, ChannelCallback* cbStorage)
         : ITimerChannel(cbStorage)
     {
         this->regs = regs;
@@ -43,21 +56,28 @@ namespace TeensyTimerTool
     {
     }
 
-    errorCode TMRChannel::begin(callback_t cb, uint32_t tcnt, bool periodic)
+    errorCode TMRChannel::begin(ChannelCallback cb, uint32_t tcnt, bool periodic)
+    {
+        return beginTicks(cb, scale.ticks(tcnt), periodic);
+    }
+
+    errorCode TMRChannel::begin(ChannelCallback cb, float tcnt, bool periodic)
     {
-        return begin(cb, (float)tcnt, periodic);
+        return beginTicks(cb, scale.ticks(tcnt), periodic);
     }
 
-    errorCode TMRChannel::begin(callback_t cb, float tcnt, bool periodic)
+    errorCode TMRChannel::beginTicks(ChannelCallback cb, uint64_t ticks, bool periodic)
     {
-        float t = tcnt * (150.0f / pscValue);
+        if (isAutoPsc) autoPrescaler(ticks);
+        ticks = atLeastOneTick(ticks);
+
         uint16_t reload;
-        if(t > 0xFFFF)
+        if(ticks > 0xFFFF)
         {
             postError(errorCode::periodOverflow);
             reload = 0xFFFE;
         }
-        else reload = (uint16_t)t - 1;
+        else reload = (uint16_t)ticks - 1;
 
         regs->CTRL = 0x0000;
         regs->LOAD = 0x0000;
@@ -66,7 +86,7 @@ namespace TeensyTimerTool
         regs->CNTR = 0x0000;
         setCallback(cb);
         regs->CSCTRL &= ~TMR_CSCTRL_TCF1;
-        regs->CSCTRL |= TMR_CSCTRL_TCF1EN;
+        regs->CSCTRL |= TMR_CSCTRL_TCF1EN | TMR_CSCTRL_CL1(1); // COMP1 is reloaded from CMPLD1 at each compare, see setPeriodTicks
 
         if (!periodic)
             regs->CTRL = TMR_CTRL_CM(1) | TMR_CTRL_PCS(pscBits) | TMR_CTRL_ONCE | TMR_CTRL_LENGTH;
@@ -74,18 +94,31 @@ namespace TeensyTimerTool
         else
             regs->CTRL = TMR_CTRL_CM(1) | TMR_CTRL_PCS(pscBits) | TMR_CTRL_LENGTH;
 
-        return t > 0xFFFF ? errorCode::periodOverflow : errorCode::OK;
+        return ticks > 0xFFFF ? errorCode::periodOverflow : errorCode::OK;
     }
 
     errorCode TMRChannel::trigger(uint32_t tcnt)
     {
-        return trigger((float)tcnt);
+        return triggerTicks(scale.ticks(tcnt));
     }
 
-    errorCode TMRChannel::trigger(float tcnt) // quick and dirty, should be optimized
+    errorCode TMRChannel::trigger(float tcnt)
     {
-        float t = tcnt * (150.0f / pscValue);
-        uint16_t reload = t > 0xFFFF ? 0xFFFF : (uint16_t)t;
+        return triggerTicks(scale.ticks(tcnt));
+    }
+
+    errorCode TMRChannel::triggerTicks(uint64_t ticks)
+    {
+        if (isAutoPsc) autoPrescaler(ticks);
+        ticks = atLeastOneTick(ticks);
+
+        uint16_t reload;
+        if (ticks > 0xFFFF)
+        {
+            postError(errorCode::periodOverflow);
+            reload = 0xFFFE;
+        }
+        else reload = (uint16_t)ticks - 1; // counts 0..reload, i.e. ticks, same as beginTicks
 
         regs->CTRL = 0x0000;
         regs->LOAD = 0x0000;
@@ -98,18 +131,55 @@ namespace TeensyTimerTool
 
         regs->CTRL = TMR_CTRL_CM(1) | TMR_CTRL_PCS(pscBits) | TMR_CTRL_ONCE | TMR_CTRL_LENGTH;
 
+        return ticks > 0xFFFF ? errorCode::periodOverflow : errorCode::OK;
+    }
+
+    errorCode TMRChannel::setPeriodTicks(uint64_t ticks)
+    {
+        if (isAutoPsc) ticks >>= (pscBits & 0b0111); // the prescaler can't be changed without stopping the counter
+        ticks = atLeastOneTick(ticks);               // shorter than one prescaled tick
+
+        if (ticks > 0xFFFF)
+        {
+            regs->CMPLD1 = 0xFFFE;
+            return postError(errorCode::periodOverflow);
+        }
+        regs->CMPLD1 = (uint16_t)ticks - 1; // preload, the running period is not affected
         return errorCode::OK;
     }
 
-    void TMRChannel::setPrescaler(uint32_t psc) // psc 0..7 -> prescaler: 1..128
+    uint32_t TMRChannel::getPeriod()
+    {
+        return (regs->CMPLD1 + 1) * (isAutoPsc ? pscValue : 1.0f) / scale.ticksPerMicrosecond();
+    }
+
+    void TMRChannel::setPrescaler(int psc) // psc 0..7 -> prescaler: 1..128
     {
+        isAutoPsc = psc == PSC_AUTO;
+        if (isAutoPsc) psc = PSC_1;
+
         pscValue = 1 << (psc & 0b0111);
         pscBits = 0b1000 | (psc & 0b0111);
+        scale = TickScale(150'000'000 >> (psc & 0b0111));
+    }
+
+    // selects the smallest prescaler which fits the 150MHz ticks into the 16bit counter and scales them accordingly
+    void TMRChannel::autoPrescaler(uint64_t& ticks)
+    {
+        uint32_t psc = 0;
+        if (ticks > 0xFFFF)
+        {
+            uint64_t excess = ticks >> 16; // fits if ticks < 0x1'0000 << psc, i.e. excess < 1 << psc
+            psc = excess > 0x7F ? 7 : 32 - __builtin_clz((uint32_t)excess);
+        }
+        pscValue = 1 << psc;
+        pscBits = 0b1000 | psc;
+        ticks >>= psc;
     }
 
     float TMRChannel::getMaxPeriod()
     {
-        return pscValue / 150.0f * 0xFFFE;
+        return (isAutoPsc ? 128 : pscValue) / 150.0f * 0xFFFE;
     }
 
 } // namespace TeensyTimerTool
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+namespace TeensyTimerTool
+{
+    // Conversion of microseconds to timer ticks, precalculated when a channel is configured.
+    // Integer inputs use a Q16 fixed point factor (one 32x32->64 multiplication), the result is exact
+    // if the timer clock is a multiple of 1/65536 MHz. This holds for all clocks derived from integer MHz
+    // clocks by a power of two prescaler.
+    // Nanoseconds are converted exactly (truncating) using the reduced ratio clockHz / 1E9.
+
+    // Durations shorter than one tick convert to 0 ticks. The channels load ticks - 1 (or add the ticks to the counter),
+    // 0 would wrap to the longest possible period. beginTicks, triggerTicks and setPeriodTicks pass their ticks through this.
+    constexpr uint64_t atLeastOneTick(uint64_t ticks) { return ticks == 0 ? 1 : ticks; }
+
+    constexpr uint32_t tickScaleGcd(uint32_t a, uint32_t b) { return b == 0 ? a : tickScaleGcd(b, a % b); }
+
+    class TickScale
+    {
+     public:
+        constexpr TickScale(uint32_t clockHz = 1'000'000)
+            : q16(((uint64_t)clockHz << 16) / 1'000'000), factor(clockHz * 1E-6f),
+              num(clockHz / tickScaleGcd(clockHz, 1'000'000'000)), den(1'000'000'000 / tickScaleGcd(clockHz, 1'000'000'000)) {}
+
+        inline uint64_t ticks(uint32_t micros) const { return ((uint64_t)micros * q16) >> 16; }
+        inline uint64_t ticks(float micros) const // saturates at 2^32 ticks, i.e. above the range of all hardware timers
+        {
+            float t = micros * factor;
+            return t < 4294967296.0f ? (uint32_t)t : 1ULL << 32;
+        }
+        inline uint64_t ticksFromNanos(uint64_t ns) const { return ns / den * num + ns % den * num / den; } // split to avoid overflow
+        inline float ticksPerMicrosecond() const { return factor; }
+
+     protected:
+        uint32_t q16;  // ticks per µs, Q16
+        float factor;  // ticks per µs
+        uint32_t num, den; // ticks per ns = num / den
+    };
+}
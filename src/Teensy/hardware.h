@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+
+// Register types of the register blocks defined by the library (GPT, FTM) and the few cpu
+// instructions used by the timer backends. The register level simulator (extras/simulator)
+// provides simHardware.h to replace them by models of the hardware.
+
+#if __has_include("simHardware.h")
+    #include "simHardware.h"
+#else
+namespace TeensyTimerTool
+{
+    using reg32_t = volatile uint32_t;
+
+    inline void dataSyncBarrier() { asm volatile("dsb"); } // wait until register changes propagated through the cache
+
+    inline uint32_t readPrimask()
+    {
+        uint32_t primask;
+        __asm__ volatile("mrs %0, primask\n" : "=r"(primask)::"memory");
+        return primask;
+    }
+}
+#endif
@@ -4,6 +4,9 @@
 #include "timer.h"
 #include "periodicTimer.h"
 #include "oneShotTimer.h"
-#include "ErrorHandling/error_handler.h"
+#include "staticPeriodicTimer.h"
 
-static_assert(TEENSYDUINO >= 150, "This library requires Teensyduino > 1.5");
\ No newline at end of file
+#if defined(TEENSYDUINO)
+    #include "ErrorHandling/error_handler.h"
+    static_assert(TEENSYDUINO >= 150, "This library requires Teensyduino > 1.5");
+#endif
\ No newline at end of file
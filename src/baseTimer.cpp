@@ -1,6 +1,11 @@
 #include "baseTimer.h"
 #include "types.h"
 
+#if defined(ENABLE_TIMER_STATS) && defined(TEENSYDUINO)
+    #include "Teensy/hardware.h"
+    #include "core_pins.h"
+#endif
+
 namespace TeensyTimerTool
 {
 
@@ -13,6 +18,24 @@ namespace TeensyTimerTool
         this->isPeriodic = periodic;
     }
 
+#if defined(ENABLE_TIMER_STATS)
+    TimerStats BaseTimer::getStats(bool reset)
+    {
+        if (timerChannel == nullptr) return TimerStats();
+
+    #if defined(TEENSYDUINO)
+        uint32_t primask = readPrimask();
+        __disable_irq(); // the isr might record in between
+    #endif
+        TimerStats stats = timerChannel->stats;
+        if (reset) timerChannel->stats = TimerStats();
+    #if defined(TEENSYDUINO)
+        if (primask == 0) __enable_irq();
+    #endif
+        return stats;
+    }
+#endif
+
 
 
 
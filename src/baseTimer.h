@@ -3,6 +3,7 @@
 //#include "Arduino.h"
 #include "ErrorHandling/error_codes.h"
 #include "ITimerChannel.h"
+#include "durationLiterals.h"
 
 #include <type_traits>
 
@@ -13,17 +14,41 @@ namespace TeensyTimerTool
      public:
         template <typename T>
         inline errorCode begin(callback_t callback, T period, bool start = true);
+        template <typename T>
+        inline errorCode begin(ctxCallback_t callback, void* context, T period, bool start = true); // invokes callback(context)
+        template <typename T, typename = typename std::enable_if<isPeriod<T>::value>::type>
+        inline errorCode begin(ctxCallback_t callback, T period, bool start = true);                // invokes callback((BaseTimer*)this)
         inline errorCode end() { return errorCode::notImplemented; }
         inline errorCode stop() { return timerChannel->stop(); }
         inline float getMaxPeriod() const;
+        template <typename T>
+        inline errorCode setPeriod(T period); // running timers switch to the new period at the next reload, without stopping the counter
+        inline uint32_t getPeriod() const;    // µs
+        template <typename T>
+        inline uint64_t toTicks(T period) const; // converts µs or durations to native ticks of the channel, valid after begin()
 
         #if defined(ENABLE_ADVANCED_FEATURES)
         ITimerChannel* getChannel() {return timerChannel;}
         #endif
 
+        #if defined(ENABLE_TIMER_STATS)
+        TimerStats getStats(bool reset = false); // consistent copy of the lateness statistics, optionally clears them
+        #endif
+
      protected:
         BaseTimer(TimerGenerator* generator, bool periodic);
 
+        template <typename T>
+        inline errorCode beginChannel(ChannelCallback callback, T period, bool start);
+        inline errorCode acquireChannel();
+        inline errorCode beginPeriod(ChannelCallback callback, uint32_t micros) { return timerChannel->begin(callback, micros, isPeriodic); }
+        inline errorCode beginPeriod(ChannelCallback callback, float micros) { return timerChannel->begin(callback, micros, isPeriodic); }
+        inline errorCode beginPeriod(ChannelCallback callback, std::chrono::nanoseconds nanos);
+
+        static inline uint64_t periodToTicks(ITimerChannel* channel, uint32_t micros) { return channel->ticksFromMicros(micros); }
+        static inline uint64_t periodToTicks(ITimerChannel* channel, float micros) { return channel->ticksFromMicros(micros); }
+        static inline uint64_t periodToTicks(ITimerChannel* channel, std::chrono::nanoseconds nanos) { return channel->ticksFromNanos(nanos.count()); }
+
         TimerGenerator* timerGenerator;
         ITimerChannel* timerChannel;
         bool isPeriodic;
@@ -36,8 +61,43 @@ namespace TeensyTimerTool
     errorCode BaseTimer::begin(callback_t callback, T period, bool start)
     {
         if (callback == nullptr) return postError(errorCode::callback);
-        if (isPeriodic && period == 0) return postError(errorCode::reload);
+        return beginChannel(callback, period, start);
+    }
+
+    template <typename T>
+    errorCode BaseTimer::begin(ctxCallback_t callback, void* context, T period, bool start)
+    {
+        if (callback == nullptr) return postError(errorCode::callback);
+        return beginChannel(ChannelCallback(callback, context), period, start);
+    }
 
+    template <typename T, typename>
+    errorCode BaseTimer::begin(ctxCallback_t callback, T period, bool start)
+    {
+        return begin(callback, this, period, start);
+    }
+
+    template <typename T>
+    errorCode BaseTimer::beginChannel(ChannelCallback callback, T period, bool start)
+    {
+        static_assert(isPeriod<T>::value, "only floating point, integral or duration types allowed");
+        auto p = toPeriod(period); // ConstDurations are converted at compile time
+
+        if (isPeriodic && p == decltype(p)(0)) return postError(errorCode::reload);
+
+        errorCode err = acquireChannel();
+        if (err != errorCode::OK) return err;
+
+        err = beginPeriod(callback, p);
+
+        if (err == errorCode::OK && isPeriodic && start)
+                timerChannel->start();
+
+        return err;
+    }
+
+    errorCode BaseTimer::acquireChannel()
+    {
         if (timerChannel == nullptr)
         {
             if (timerGenerator != nullptr) // use timer passed in during construction
@@ -53,24 +113,51 @@ namespace TeensyTimerTool
             }
             if (timerChannel == nullptr) return postError(errorCode::noFreeModule);
         }
+        return errorCode::OK;
+    }
 
-        static_assert(std::is_floating_point<T>() || std::is_integral<T>(), "only floating point or integral types allowed");
+    float BaseTimer::getMaxPeriod() const
+    {
+        if (timerChannel != nullptr) return timerChannel->getMaxPeriod();
+        postError(errorCode::notInitialized);
+        return 0;
+    }
 
-        errorCode err = std::is_floating_point<T>() ?
-            timerChannel->begin(callback, (float)period, isPeriodic) :
-            timerChannel->begin(callback, (uint32_t)period, isPeriodic);
+    template <typename T>
+    errorCode BaseTimer::setPeriod(T period)
+    {
+        static_assert(isPeriod<T>::value, "Only floating point, integral or duration types allowed");
+        auto p = toPeriod(period);
 
-        if (err == errorCode::OK && isPeriodic && start)
-                timerChannel->start();
+        if (timerChannel == nullptr) return postError(errorCode::notInitialized);
+        if (isPeriodic && p == decltype(p)(0)) return postError(errorCode::reload);
 
-        return err;
+        return timerChannel->setPeriodTicks(periodToTicks(timerChannel, p));
     }
 
-    float BaseTimer::getMaxPeriod() const
+    uint32_t BaseTimer::getPeriod() const
     {
-        if (timerChannel != nullptr) return timerChannel->getMaxPeriod();
+        if (timerChannel != nullptr) return timerChannel->getPeriod();
         postError(errorCode::notInitialized);
         return 0;
     }
 
+    errorCode BaseTimer::beginPeriod(ChannelCallback callback, std::chrono::nanoseconds nanos)
+    {
+        return timerChannel->beginTicks(callback, timerChannel->ticksFromNanos(nanos.count()), isPeriodic);
+    }
+
+    template <typename T>
+    uint64_t BaseTimer::toTicks(T period) const
+    {
+        static_assert(isPeriod<T>::value, "Only floating point, integral or duration types allowed");
+
+        if (timerChannel == nullptr)
+        {
+            postError(errorCode::notInitialized);
+            return 0;
+        }
+        return periodToTicks(timerChannel, toPeriod(period));
+    }
+
 }
\ No newline at end of file
@@ -6,8 +6,8 @@ namespace TeensyTimerTool
     class ITimerChannel;
     using TimerGenerator = ITimerChannel*(); //returns a pointer to a free timer channel or nullptr
 
-    // TEENSYDUINO  ==========================================================================
-    #if defined(TEENSYDUINO)
+    // TEENSYDUINO / LINUX HOST ==============================================================
+    #if defined(TEENSYDUINO) || defined(__linux__)
 
         #if defined(ARDUINO_TEENSYLC)
             extern TimerGenerator *const TCK;
@@ -30,9 +30,13 @@ namespace TeensyTimerTool
 
         #elif defined(ARDUINO_TEENSY40) || defined(ARDUINO_TEENSY41)
             extern TimerGenerator *const TMR1, *const TMR2, *const TMR3, *const TMR4;
+            extern TimerGenerator *const TMR1_32, *const TMR2_32, *const TMR3_32, *const TMR4_32; // cascaded channel pairs
             extern TimerGenerator *const GPT1, *const GPT2;
             extern TimerGenerator *const PIT;
             extern TimerGenerator *const TCK;
+
+        #elif defined(__linux__)
+            extern TimerGenerator *const TCK; // software timers of the host backend, see src/Linux
         #else
             #error BOARD NOT SUPPORTED
         #endif
@@ -41,6 +45,16 @@ namespace TeensyTimerTool
         #define YIELD_STANDARD  1
         #define YIELD_OPTIMIZED 2
 
+        #define TCK_SCHEDULER_SCAN    0
+        #define TCK_SCHEDULER_SORTED  1
+        #define TCK_SCHEDULER_WHEEL   2
+        #define TCK_SCHEDULER_COMPACT 3
+
+        #define TCK_RESTART  0
+        #define TCK_FIRE_ALL 1
+        #define TCK_SKIP     2
+        #define TCK_COALESCE 3
+
         constexpr int PSC_AUTO = -1;
         constexpr int PSC_1 = 0;
         constexpr int PSC_2 = 1;
@@ -52,6 +66,8 @@ namespace TeensyTimerTool
         constexpr int PSC_128 = 7;
 
         extern void(* const tick)();
+        extern uint32_t(* const tckMissedPeriods)();
+        extern uint32_t(* const tckTicksUntilDue)(); // TCK ticks (cpu cycles, µs on the T-LC, ns on Linux) until the next TCK deadline
 
 
     // ESP32  ==========================================================================
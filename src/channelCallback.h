@@ -0,0 +1,41 @@
+#pragma once
+
+#include "types.h"
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace TeensyTimerTool
+{
+    using ctxCallback_t = void (*)(void* context);
+
+    // Callback storage of the timer channels. Holds either a callback_t or a plain function pointer plus
+    // context. The latter is invoked directly, i.e. without the type erasure overhead of std::function.
+    class ChannelCallback
+    {
+     public:
+        ChannelCallback() = default;
+        ChannelCallback(std::nullptr_t) {}
+        ChannelCallback(ctxCallback_t function, void* context) : function(function), context(context) {}
+
+        template <typename F, typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, ChannelCallback>::value &&
+                                                                  std::is_convertible<F, callback_t>::value>::type>
+        ChannelCallback(F&& cb) : callback(std::forward<F>(cb)) {}
+
+        inline void operator()() const
+        {
+            if (function != nullptr)
+                function(context);
+            else
+                callback();
+        }
+
+        friend bool operator==(const ChannelCallback& cb, std::nullptr_t) { return cb.function == nullptr && cb.callback == nullptr; }
+        friend bool operator!=(const ChannelCallback& cb, std::nullptr_t) { return !(cb == nullptr); }
+
+     protected:
+        ctxCallback_t function = nullptr;
+        void* context = nullptr;
+        callback_t callback = nullptr;
+    };
+}
@@ -2,6 +2,8 @@
 #include "boardDef.h"
 
 using tick_t = void (*) ();
+using missedPeriods_t = uint32_t (*) ();
+using ticksUntilDue_t = uint32_t (*) ();
 
 #if defined(ARDUINO_TEENSY40) || defined(ARDUINO_TEENSY41)
     #include "Teensy/TMR/TMR.h"
@@ -16,6 +18,11 @@ using tick_t = void (*) ();
         TimerGenerator* const TMR3 = TMR_t<2>::getTimer;
         TimerGenerator* const TMR4 = TMR_t<3>::getTimer;
 
+        TimerGenerator* const TMR1_32 = TMR_t<0>::getCascadedTimer;
+        TimerGenerator* const TMR2_32 = TMR_t<1>::getCascadedTimer;
+        TimerGenerator* const TMR3_32 = TMR_t<2>::getCascadedTimer;
+        TimerGenerator* const TMR4_32 = TMR_t<3>::getCascadedTimer;
+
         TimerGenerator* const GPT1 = GPT_t<0>::getTimer;
         TimerGenerator* const GPT2 = GPT_t<1>::getTimer;
 
@@ -24,6 +31,8 @@ using tick_t = void (*) ();
         TimerGenerator* const TCK = TCK_t::getTimer;
 
         constexpr tick_t tick = &TCK_t::tick;
+        constexpr missedPeriods_t tckMissedPeriods = &TCK_t::missedPeriods;
+        constexpr ticksUntilDue_t tckTicksUntilDue = &TCK_t::ticksUntilDue;
     }
 
 #elif defined (ARDUINO_TEENSY35) || defined (ARDUINO_TEENSY36)
@@ -41,6 +50,8 @@ using tick_t = void (*) ();
         TimerGenerator* const FTM4 = FTM_t<3>::getTimer;
 
         constexpr tick_t tick = &TCK_t::tick;
+        constexpr missedPeriods_t tckMissedPeriods = &TCK_t::missedPeriods;
+        constexpr ticksUntilDue_t tckTicksUntilDue = &TCK_t::ticksUntilDue;
     }
 
 #elif defined(ARDUINO_TEENSY31) || defined (ARDUINO_TEENSY32)
@@ -55,6 +66,8 @@ using tick_t = void (*) ();
         TimerGenerator* const FTM1 = FTM_t<1>::getTimer;
         TimerGenerator* const FTM2 = FTM_t<2>::getTimer;
         constexpr tick_t tick = &TCK_t::tick;
+        constexpr missedPeriods_t tckMissedPeriods = &TCK_t::missedPeriods;
+        constexpr ticksUntilDue_t tckTicksUntilDue = &TCK_t::ticksUntilDue;
     }
 
 #elif defined(ARDUINO_TEENSY30)
@@ -68,6 +81,8 @@ using tick_t = void (*) ();
         TimerGenerator* const FTM0 = FTM_t<0>::getTimer;
         TimerGenerator* const FTM1 = FTM_t<1>::getTimer;
         constexpr tick_t tick = &TCK_t::tick;
+        constexpr missedPeriods_t tckMissedPeriods = &TCK_t::missedPeriods;
+        constexpr ticksUntilDue_t tckTicksUntilDue = &TCK_t::ticksUntilDue;
     }
 
 #elif defined(ARDUINO_TEENSYLC)
@@ -77,6 +92,19 @@ using tick_t = void (*) ();
     {
         TimerGenerator* const TCK = TCK_t::getTimer;
         constexpr tick_t tick = &TCK_t::tick;
+        constexpr missedPeriods_t tckMissedPeriods = &TCK_t::missedPeriods;
+        constexpr ticksUntilDue_t tckTicksUntilDue = &TCK_t::ticksUntilDue;
+    }
+
+#elif defined(__linux__)
+    #include "Linux/HOST.h"
+
+    namespace TeensyTimerTool
+    {
+        TimerGenerator* const TCK = HOST_t::getTimer;
+        constexpr tick_t tick = &HOST_t::tick;
+        constexpr missedPeriods_t tckMissedPeriods = &HOST_t::missedPeriods;
+        constexpr ticksUntilDue_t tckTicksUntilDue = &HOST_t::ticksUntilDue;
     }
 
 #endif
@@ -33,6 +33,9 @@ namespace TeensyTimerTool
 
 #elif defined(UNO)
     TimerGenerator* const timerPool[] = {TCK};
+
+#elif defined(__linux__)
+    TimerGenerator* const timerPool[] = {TCK};
 #endif
     constexpr unsigned timerCnt = sizeof(timerPool) / sizeof(timerPool[0]);
 
@@ -40,7 +43,9 @@ namespace TeensyTimerTool
 // Default settings for various timers
 
 // TMR (QUAD)
-    constexpr int TMR_DEFAULT_PSC = PSC_128;  // Allowed prescaling values: PSC_1, PSC_2, PSC_4 ... PSC_128, clock = 150MHz
+    constexpr int TMR_DEFAULT_PSC = PSC_128;  // Allowed prescaling values: PSC_AUTO, PSC_1, PSC_2, PSC_4 ... PSC_128, clock = 150MHz
+                                              // (PSC_AUTO selects the smallest prescaler fitting the period on each begin / trigger,
+                                              // a fixed prescaler gives repeatable latency. Can be changed per channel by TMRChannel::setPrescaler)
 
 // FTM
     constexpr int FTM_DEFAULT_PSC[] =         // Allowed prescaling values: PSC_AUTO, PSC_1, PSC_2, PSC_4 ... PSC_128, clock = FBUS
@@ -63,6 +68,21 @@ namespace TeensyTimerTool
                                               // YIELD_STANDARD:  uses the standard yield function and adds a call to TeensyTimerTool::tick(). Lots of overhead in yield...
                                               // YIELD_OPTIMIZED: generate an optimized yield which only calls TeensyTimerTool::Tick()  (recommended if you don't use SerialEvents)
 
+    #define TCK_SCHEDULER TCK_SCHEDULER_SCAN  // Select how TeensyTimerTool::tick() finds expired TCK timers
+                                              // TCK_SCHEDULER_SCAN:   checks all NR_OF_TCK_TIMERS channels on each tick
+                                              // TCK_SCHEDULER_SORTED: keeps the running channels in a deadline ordered list. A tick only checks the first entry,
+                                              //                       starting/stopping a channel is a bit more expensive (recommended if you use many TCK timers)
+                                              // TCK_SCHEDULER_WHEEL:  hierarchical timing wheel with O(1) start, stop and expiry and ~1µs resolution.
+                                              //                       Use this for hundreds or thousands of TCK timers (increase NR_OF_TCK_TIMERS accordingly)
+                                              // TCK_SCHEDULER_COMPACT: statically allocated channel arrays and a bit mask of the running channels.
+                                              //                       No heap, fixed RAM per timer, tick only visits running channels
+
+    #define TCK_PERIODIC TCK_RESTART          // Select how periodic TCK timers restart their period
+                                              // TCK_RESTART:  the next period starts when the callback is invoked. The timer drifts by the yield latency on each period
+                                              // TCK_FIRE_ALL: phase locked, periods missed due to a late tick are fired back to back
+                                              // TCK_SKIP:     phase locked, missed periods are dropped. The timer fires once and continues at the next aligned slot
+                                              // TCK_COALESCE: like TCK_SKIP, but the callback can read the number of dropped periods from TeensyTimerTool::tckMissedPeriods()
+
 
 //--------------------------------------------------------------------------------------------
 // Callback type
@@ -70,10 +90,23 @@ namespace TeensyTimerTool
 
 //   #define PLAIN_VANILLA_CALLBACKS
 
+// Uncomment for heap free callbacks. Captures of lambdas and functors are stored inline in a buffer of the given
+// size (bytes). Callbacks which don't fit are rejected at compile time.
+
+//   #define INPLACE_CALLBACKS 16
+
 
 //--------------------------------------------------------------------------------------------
 // Advanced Features
 // Uncomment if you need access to advanced features
 
 //   #define ENABLE_ADVANCED_FEATURES
+
+
+//--------------------------------------------------------------------------------------------
+// Timer statistics
+// Uncomment to record the lateness (timer event to callback, cpu cycles) and the overruns of each channel.
+// Costs a few register reads per callback. Read the statistics with BaseTimer::getStats()
+
+//   #define ENABLE_TIMER_STATS
 }
\ No newline at end of file
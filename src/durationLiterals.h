@@ -0,0 +1,112 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+
+namespace TeensyTimerTool
+{
+    // Durations known at compile time, generated by the literals 10_ns, 10_us, 2.5_ms, 3_s ...
+    // The value is part of the type, i.e. conversions and range checks happen at compile time.
+    // Periods which are not a whole number of µs are passed on as std::chrono::nanoseconds.
+
+    template <uint64_t ns>
+    struct ConstDuration
+    {
+        static constexpr uint64_t nanoseconds = ns;
+
+        static constexpr bool isIntegerMicros = ns % 1000 == 0 && ns / 1000 <= 0xFFFF'FFFF;
+        constexpr operator std::chrono::nanoseconds() const { return std::chrono::nanoseconds(ns); }
+
+        template <uint64_t clockHz> // split to avoid overflow of ns * clockHz
+        static constexpr uint64_t ticks() { return (ns / 1'000'000'000) * clockHz + (ns % 1'000'000'000) * clockHz / 1'000'000'000; }
+    };
+
+    template <typename T>
+    struct isConstDuration : std::false_type {};
+    template <uint64_t ns>
+    struct isConstDuration<ConstDuration<ns>> : std::true_type {};
+
+    template <typename T>
+    struct isChronoDuration : std::false_type {};
+    template <typename Rep, typename Period>
+    struct isChronoDuration<std::chrono::duration<Rep, Period>> : std::true_type {};
+
+    template <typename T> // periods can be given as numbers (µs), ConstDurations or std::chrono durations
+    struct isPeriod : std::integral_constant<bool, std::is_arithmetic<T>::value || isConstDuration<T>::value || isChronoDuration<T>::value> {};
+
+    // normalizes periods to uint32_t µs, float µs or std::chrono::nanoseconds
+
+    template <typename T>
+    constexpr typename std::enable_if<std::is_integral<T>::value, uint32_t>::type toPeriod(T micros) { return micros; }
+
+    template <typename T>
+    constexpr typename std::enable_if<std::is_floating_point<T>::value, float>::type toPeriod(T micros) { return micros; }
+
+    template <uint64_t ns>
+    constexpr typename std::enable_if<ConstDuration<ns>::isIntegerMicros, uint32_t>::type toPeriod(ConstDuration<ns>) { return ns / 1000; }
+
+    template <uint64_t ns>
+    constexpr typename std::enable_if<!ConstDuration<ns>::isIntegerMicros, std::chrono::nanoseconds>::type toPeriod(ConstDuration<ns> d) { return d; }
+
+    template <typename Rep, typename Period>
+    constexpr std::chrono::nanoseconds toPeriod(std::chrono::duration<Rep, Period> d) { return std::chrono::duration_cast<std::chrono::nanoseconds>(d); }
+
+    // LITERALS ===========================================================================
+
+    namespace literalParser
+    {
+        constexpr bool isValid(const char* str, unsigned len)
+        {
+            bool hasDot = false;
+            for (unsigned i = 0; i < len; i++)
+            {
+                char c = str[i];
+                if (c == '.' && !hasDot)
+                    hasDot = true;
+                else if ((c < '0' || c > '9') && c != '\'')
+                    return false;
+            }
+            return true;
+        }
+
+        constexpr uint64_t toNanoseconds(const char* str, unsigned len, uint64_t unit) // unit in ns
+        {
+            uint64_t mantissa = 0, divisor = 1;
+            bool fraction = false;
+            for (unsigned i = 0; i < len; i++)
+            {
+                char c = str[i];
+                if (c == '\'') continue; // digit separator
+                if (c == '.')
+                {
+                    fraction = true;
+                    continue;
+                }
+                mantissa = mantissa * 10 + (c - '0');
+                if (fraction) divisor *= 10;
+            }
+            return mantissa * unit / divisor;
+        }
+
+        template <uint64_t unit, char... chars>
+        constexpr uint64_t parse()
+        {
+            constexpr char str[] = {chars...};
+            static_assert(isValid(str, sizeof...(chars)), "Only decimal duration literals (e.g. 10_us, 2.5_ms) supported");
+            return toNanoseconds(str, sizeof...(chars), unit);
+        }
+    }
+
+    template <char... chars>
+    constexpr ConstDuration<literalParser::parse<1, chars...>()> operator"" _ns() { return {}; }
+
+    template <char... chars>
+    constexpr ConstDuration<literalParser::parse<1'000, chars...>()> operator"" _us() { return {}; }
+
+    template <char... chars>
+    constexpr ConstDuration<literalParser::parse<1'000'000, chars...>()> operator"" _ms() { return {}; }
+
+    template <char... chars>
+    constexpr ConstDuration<literalParser::parse<1'000'000'000, chars...>()> operator"" _s() { return {}; }
+}
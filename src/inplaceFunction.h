@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace TeensyTimerTool
+{
+    // Heap free replacement for std::function (see INPLACE_CALLBACKS in defaultConfig.h)
+    //
+    // The callable is stored in an inline buffer of 'capacity' bytes. Callables which don't fit
+    // are rejected at compile time, there is no heap fallback. Calling an empty function does nothing.
+
+    template <typename Signature, size_t capacity>
+    class InplaceFunction;
+
+    template <typename R, typename... Args, size_t capacity>
+    class InplaceFunction<R(Args...), capacity>
+    {
+     public:
+        InplaceFunction() noexcept : ops(&emptyOps) {}
+        InplaceFunction(std::nullptr_t) noexcept : ops(&emptyOps) {}
+
+        template <typename F, typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, InplaceFunction>::value>::type,
+                  typename = decltype(std::declval<F&>()(std::declval<Args>()...))>
+        InplaceFunction(F&& f);
+
+        InplaceFunction(const InplaceFunction& other) : ops(other.ops) { ops->copy(storage, other.storage); }
+        InplaceFunction& operator=(const InplaceFunction& other);
+        InplaceFunction& operator=(std::nullptr_t);
+        ~InplaceFunction() { ops->destroy(storage); }
+
+        R operator()(Args... args) const { return ops->invoke(storage, std::forward<Args>(args)...); }
+        explicit operator bool() const { return ops != &emptyOps; }
+
+        friend bool operator==(const InplaceFunction& f, std::nullptr_t) { return !f; }
+        friend bool operator!=(const InplaceFunction& f, std::nullptr_t) { return (bool)f; }
+
+     protected:
+        struct Ops
+        {
+            R (*invoke)(const void* storage, Args...);
+            void (*copy)(void* dst, const void* src);
+            void (*destroy)(void* storage);
+        };
+
+        template <typename F>
+        struct OpsFor
+        {
+            static R invoke(const void* s, Args... args) { return (*(F*)s)(std::forward<Args>(args)...); }
+            static void copy(void* dst, const void* src) { new (dst) F(*(const F*)src); }
+            static void destroy(void* s) { ((F*)s)->~F(); }
+            static constexpr Ops ops{invoke, copy, destroy};
+        };
+
+        template <typename F>
+        static bool isNull(const F&) { return false; }
+        template <typename T>
+        static bool isNull(T* f) { return f == nullptr; } // null function pointers give an empty function, like std::function
+
+        static R emptyInvoke(const void*, Args...) { return R(); }
+        static void emptyCopy(void*, const void*) {}
+        static void emptyDestroy(void*) {}
+        static constexpr Ops emptyOps{emptyInvoke, emptyCopy, emptyDestroy};
+
+        const Ops* ops;
+        alignas(8) mutable unsigned char storage[capacity];
+    };
+
+    // IMPLEMENTATION ====================================================
+
+    template <typename R, typename... Args, size_t capacity>
+    template <typename F, typename, typename>
+    InplaceFunction<R(Args...), capacity>::InplaceFunction(F&& f)
+    {
+        using callable_t = typename std::decay<F>::type;
+        static_assert(sizeof(callable_t) <= capacity, "Callback too large, increase INPLACE_CALLBACKS or capture less");
+        static_assert(alignof(callable_t) <= 8, "Callback alignment not supported");
+
+        ops = &emptyOps;
+        if (isNull(f)) return;
+
+        new (storage) callable_t(std::forward<F>(f));
+        ops = &OpsFor<callable_t>::ops;
+    }
+
+    template <typename R, typename... Args, size_t capacity>
+    InplaceFunction<R(Args...), capacity>& InplaceFunction<R(Args...), capacity>::operator=(const InplaceFunction& other)
+    {
+        if (this != &other)
+        {
+            ops->destroy(storage);
+            ops = other.ops;
+            ops->copy(storage, other.storage);
+        }
+        return *this;
+    }
+
+    template <typename R, typename... Args, size_t capacity>
+    InplaceFunction<R(Args...), capacity>& InplaceFunction<R(Args...), capacity>::operator=(std::nullptr_t)
+    {
+        ops->destroy(storage);
+        ops = &emptyOps;
+        return *this;
+    }
+
+    template <typename R, typename... Args, size_t capacity>
+    template <typename F>
+    constexpr typename InplaceFunction<R(Args...), capacity>::Ops InplaceFunction<R(Args...), capacity>::OpsFor<F>::ops;
+
+    template <typename R, typename... Args, size_t capacity>
+    constexpr typename InplaceFunction<R(Args...), capacity>::Ops InplaceFunction<R(Args...), capacity>::emptyOps;
+}
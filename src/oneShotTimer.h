@@ -12,8 +12,16 @@ namespace TeensyTimerTool
         inline OneShotTimer(TimerGenerator* generator = nullptr);
 
         inline errorCode begin(callback_t cb);
+        inline errorCode begin(ctxCallback_t cb, void* context); // invokes cb(context)
+        inline errorCode begin(ctxCallback_t cb);                // invokes cb((BaseTimer*)this)
         template <typename T> errorCode trigger(T delay);
+        inline errorCode triggerTicks(uint64_t ticks); // native ticks, see toTicks()
         inline errorCode stop();
+
+     protected:
+        inline errorCode triggerPeriod(uint32_t micros) { return timerChannel->trigger(micros); }
+        inline errorCode triggerPeriod(float micros) { return timerChannel->trigger(micros); }
+        inline errorCode triggerPeriod(std::chrono::nanoseconds nanos) { return timerChannel->triggerTicks(timerChannel->ticksFromNanos(nanos.count())); }
     };
 
 
@@ -28,19 +36,27 @@ namespace TeensyTimerTool
         return BaseTimer::begin(callback, 0,  false);
     }
 
+    errorCode OneShotTimer::begin(ctxCallback_t callback, void* context)
+    {
+        return BaseTimer::begin(callback, context, 0, false);
+    }
+
+    errorCode OneShotTimer::begin(ctxCallback_t callback)
+    {
+        return BaseTimer::begin(callback, this, 0, false);
+    }
+
     template <typename T>
     errorCode OneShotTimer::trigger(T delay)
     {
-        static_assert(std::is_integral<T>() || std::is_floating_point<T>(), "Only floating point or integral types allowed");
-
-        errorCode result;
+        static_assert(isPeriod<T>::value, "Only floating point, integral or duration types allowed");
 
-        if (std::is_floating_point<T>())
-            result = timerChannel->trigger((float) delay);
-        else
-            result = timerChannel->trigger((uint32_t) delay);
+        return triggerPeriod(toPeriod(delay)); // ConstDurations are converted at compile time
+    }
 
-        return result;
+    errorCode OneShotTimer::triggerTicks(uint64_t ticks)
+    {
+        return timerChannel->triggerTicks(ticks);
     }
 
     errorCode OneShotTimer::stop()
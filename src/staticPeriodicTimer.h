@@ -0,0 +1,58 @@
+#pragma once
+
+#include "baseTimer.h"
+
+#if defined(ARDUINO_TEENSY40) || defined(ARDUINO_TEENSY41)
+    #include "Teensy/GPT/GPT.h"
+    #include "Teensy/PIT4/PIT.h"
+    #include "Teensy/TMR/TMR.h"
+#elif defined(ARDUINO_TEENSY30) || defined(ARDUINO_TEENSY31) || defined(ARDUINO_TEENSY32) || defined(ARDUINO_TEENSY35) || defined(ARDUINO_TEENSY36)
+    #include "Teensy/FTM/FTM.h"
+#endif
+
+namespace TeensyTimerTool
+{
+    // Periodic timer bound to a hardware channel and a handler at compile time. E.g.
+    //
+    //   StaticPeriodicTimer<TMR_t<0>, 2, onTick> t;   // TMR1, channel 2
+    //   t.begin(10);                                  // 100kHz
+    //
+    // The module gets a dedicated isr which calls the handler directly, i.e. there is no
+    // callback indirection and the compiler can inline the handler.
+    // Periods given as duration literals (t.begin(10_us)) are converted to ticks at compile time,
+    // periods exceeding the range of the module are rejected by a static_assert.
+    // Modules: TMR_t<0..3>, GPT_t<0..1>, PIT_t (T4.x) and FTM_t<0..3> (T3.x). Only one static timer per module,
+    // the remaining channels of the module can still be used by the normal timers.
+
+    template <typename Module, unsigned chNr, void (*handler)()>
+    class StaticPeriodicTimer : public BaseTimer
+    {
+     public:
+        StaticPeriodicTimer()
+            : BaseTimer(Module::template getStaticTimer<chNr, handler>, true) {}
+
+        template <typename T>
+        inline errorCode begin(T period, bool start = true) { return beginChannel(nullptr, period, start); }
+
+        template <uint64_t ns>
+        inline errorCode begin(ConstDuration<ns> period, bool start = true);
+    };
+
+    // IMPLEMENTATION =====================================================================
+
+    template <typename Module, unsigned chNr, void (*handler)()>
+    template <uint64_t ns>
+    errorCode StaticPeriodicTimer<Module, chNr, handler>::begin(ConstDuration<ns>, bool start)
+    {
+        constexpr uint64_t ticks = ConstDuration<ns>::template ticks<Module::clockHz>();
+        static_assert(ticks > 0, "Period shorter than one timer tick");
+        static_assert(ticks <= Module::maxTicks, "Period exceeds the range of the timer module");
+
+        errorCode err = acquireChannel();
+        if (err != errorCode::OK) return err;
+
+        err = timerChannel->beginTicks(nullptr, ticks, true);
+        if (err == errorCode::OK && start) timerChannel->start();
+        return err;
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+
+namespace TeensyTimerTool
+{
+    // Lateness statistics of a timer channel, recorded by the isr / TCK dispatcher if ENABLE_TIMER_STATS is defined.
+    // Lateness is the time from the timer event (compare match, TCK deadline) to the start of the callback
+    // in cpu cycles (TCK on the T-LC: µs). Read them with BaseTimer::getStats().
+    struct TimerStats
+    {
+        static constexpr unsigned nrOfBins = 33;
+
+        uint32_t count = 0;                // recorded callbacks
+        uint32_t overruns = 0;             // callbacks which returned after the next event of their channel was due
+        uint32_t min = 0xFFFF'FFFF, max = 0;
+        uint64_t sum = 0;
+        uint32_t histogram[nrOfBins] = {}; // bin 0: lateness 0, bin n: 2^(n-1) <= lateness < 2^n
+
+        float mean() const { return count != 0 ? (float)sum / count : 0.0f; }
+        inline void record(uint32_t lateness);
+    };
+
+    // IMPLEMENTATION ====================================================
+
+    void TimerStats::record(uint32_t lateness)
+    {
+        count++;
+        sum += lateness;
+        if (lateness < min) min = lateness;
+        if (lateness > max) max = lateness;
+        histogram[lateness == 0 ? 0 : 32 - __builtin_clz(lateness)]++;
+    }
+
+} // namespace TeensyTimerTool
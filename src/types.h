@@ -2,7 +2,18 @@
 #include "ErrorHandling/error_codes.h"
 #include "config.h"
 
-#if not defined(PLAIN_VANILLA_CALLBACKS)
+#if defined(INPLACE_CALLBACKS)
+
+    #include "inplaceFunction.h"
+    namespace TeensyTimerTool
+    {
+        using callback_t = InplaceFunction<void(void), INPLACE_CALLBACKS>;
+        using errorFunc_t = InplaceFunction<void(errorCode), INPLACE_CALLBACKS>;
+
+        extern void attachErrFunc(errorFunc_t);
+        extern errorCode postError(errorCode);
+    }
+#elif not defined(PLAIN_VANILLA_CALLBACKS)
 
     #include <functional>
     inline void std::__throw_bad_function_call()